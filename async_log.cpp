@@ -0,0 +1,210 @@
+#include "stdafx.h"
+#include "async_log.h"
+#include "gzstream.h"
+#include <iomanip>
+
+static const char logMagic[] = "KLOG1";
+
+static string& getThreadLine() {
+  static thread_local string line;
+  return line;
+}
+
+static int getThreadIndex() {
+  static atomic<int> numThreads(0);
+  static thread_local int index = numThreads++;
+  return index;
+}
+
+namespace {
+// Appends everything written to the stream to the line of the writing thread, so that many threads can
+// log at the same time without interleaving their lines.
+class ThreadLineBuf : public std::streambuf {
+  protected:
+  virtual int_type overflow(int_type c) override {
+    if (c != traits_type::eof())
+      getThreadLine().push_back(traits_type::to_char_type(c));
+    return traits_type::not_eof(c);
+  }
+
+  virtual std::streamsize xsputn(const char* s, std::streamsize n) override {
+    getThreadLine().append(s, n);
+    return n;
+  }
+};
+}
+
+static std::ostream& getThreadStream() {
+  static thread_local ThreadLineBuf lineBuf;
+  static thread_local std::ostream stream(&lineBuf);
+  return stream;
+}
+
+static recursive_mutex instancesMutex;
+
+static vector<AsyncLog*>& getInstances() {
+  static vector<AsyncLog*> ret;
+  return ret;
+}
+
+AsyncLog::AsyncLog(const string& path) : slots(new Slot[numSlots]), enqueuePos(0), numWritten(0),
+    finished(false), flushRequested(false), disabled(false), startTime(steady_clock::now()),
+    file(new ogzstream(path.c_str())) {
+  for (size_t i = 0; i < numSlots; ++i)
+    slots[i].sequence = i;
+  file->write(logMagic, sizeof(logMagic));
+  startWriter();
+  RecursiveLock lock(instancesMutex);
+  getInstances().push_back(this);
+}
+
+AsyncLog::~AsyncLog() {
+  {
+    RecursiveLock lock(instancesMutex);
+    getInstances().removeElement(this);
+  }
+  stopWriter();
+  file->close();
+}
+
+void AsyncLog::startWriter() {
+  finished = false;
+  writer = makeThread([this] { writerLoop(); });
+}
+
+void AsyncLog::stopWriter() {
+  if (writer.joinable()) {
+    finished = true;
+    writer.join();
+  }
+}
+
+void AsyncLog::prepareFork() {
+  RecursiveLock lock(instancesMutex);
+  for (auto log : getInstances())
+    log->stopWriter();
+}
+
+void AsyncLog::afterFork(bool inChild) {
+  RecursiveLock lock(instancesMutex);
+  for (auto log : getInstances())
+    if (inChild)
+      log->disabled = true;
+    else
+      log->startWriter();
+}
+
+DebugOutput AsyncLog::getOutput() {
+  return DebugOutput(&getThreadStream, [this] { push(getThreadLine()); });
+}
+
+void AsyncLog::flush() {
+  if (disabled)
+    return;
+  auto target = enqueuePos.load();
+  flushRequested = true;
+  while (numWritten < target || flushRequested)
+    sleep_for(milliseconds(1));
+}
+
+void AsyncLog::push(string& line) {
+  if (disabled) {
+    line.clear();
+    return;
+  }
+  auto time = duration_cast<microseconds>(steady_clock::now() - startTime).count();
+  size_t pos = enqueuePos.load(std::memory_order_relaxed);
+  Slot* slot = nullptr;
+  while (1) {
+    slot = &slots[pos % numSlots];
+    auto diff = (long long) slot->sequence.load(std::memory_order_acquire) - (long long) pos;
+    if (diff == 0) {
+      if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+        break;
+    } else if (diff < 0) {
+      // The buffer is full, wait for the writer to catch up.
+      sleep_for(milliseconds(1));
+      pos = enqueuePos.load(std::memory_order_relaxed);
+    } else
+      pos = enqueuePos.load(std::memory_order_relaxed);
+  }
+  // Swap instead of copying, so the thread gets the slot's old buffer to write its next line into.
+  slot->line.swap(line);
+  line.clear();
+  slot->time = time;
+  slot->threadIndex = getThreadIndex();
+  slot->sequence.store(pos + 1, std::memory_order_release);
+}
+
+static void writeNumber(std::ostream& out, unsigned long long value) {
+  while (value >= 0x80) {
+    out.put(char((value & 0x7f) | 0x80));
+    value >>= 7;
+  }
+  out.put(char(value));
+}
+
+static optional<unsigned long long> readNumber(std::istream& in) {
+  unsigned long long ret = 0;
+  for (int shift = 0; shift < 64; shift += 7) {
+    int c = in.get();
+    if (c == EOF)
+      return none;
+    ret |= (unsigned long long)(c & 0x7f) << shift;
+    if (!(c & 0x80))
+      return ret;
+  }
+  return none;
+}
+
+bool AsyncLog::writeNext() {
+  auto& slot = slots[dequeuePos % numSlots];
+  if (slot.sequence.load(std::memory_order_acquire) != dequeuePos + 1)
+    return false;
+  // Lines from different threads may come in slightly out of order, so the time is stored as a signed offset.
+  auto timeDiff = slot.time - lastTime;
+  lastTime = slot.time;
+  writeNumber(*file, timeDiff >= 0 ? timeDiff * 2 : -timeDiff * 2 - 1);
+  writeNumber(*file, slot.threadIndex);
+  writeNumber(*file, slot.line.size());
+  file->write(slot.line.data(), slot.line.size());
+  slot.line.clear();
+  slot.sequence.store(dequeuePos + numSlots, std::memory_order_release);
+  ++dequeuePos;
+  ++numWritten;
+  return true;
+}
+
+void AsyncLog::writerLoop() {
+  while (!finished) {
+    if (!writeNext()) {
+      if (flushRequested) {
+        file->flush();
+        flushRequested = false;
+      }
+      sleep_for(milliseconds(1));
+    }
+  }
+  while (writeNext()) {}
+  file->flush();
+}
+
+void AsyncLog::decode(const string& path, std::ostream& out) {
+  igzstream in(path.c_str());
+  char magic[sizeof(logMagic)];
+  in.read(magic, sizeof(magic));
+  USER_CHECK(in && string(magic, sizeof(magic)) == string(logMagic, sizeof(logMagic))) << path << " is not a log file";
+  long long time = 0;
+  string line;
+  while (auto timeDiff = readNumber(in)) {
+    time += (*timeDiff % 2 == 0) ? (long long)(*timeDiff / 2) : -(long long)((*timeDiff + 1) / 2);
+    auto threadIndex = readNumber(in);
+    auto size = readNumber(in);
+    if (!threadIndex || !size)
+      break;
+    line.resize(*size);
+    in.read(&line[0], *size);
+    out << time / 1000 << "." << std::setw(3) << std::setfill('0') << time % 1000 << std::setfill(' ')
+        << " [" << *threadIndex << "] " << line << "\n";
+  }
+}
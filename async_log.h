@@ -0,0 +1,54 @@
+#pragma once
+
+#include "util.h"
+#include "debug.h"
+
+class ogzstream;
+
+/** Log output that doesn't block the logging thread on compressing and writing to a file. The logging
+    thread formats each line into its own buffer. Finished lines are put in a lock-free ring buffer, and
+    a background thread writes them to a compressed binary log, stamped with the time and the thread that
+    logged them. Use decode() to turn the log back into text.*/
+class AsyncLog {
+  public:
+  AsyncLog(const string& path);
+  ~AsyncLog();
+
+  DebugOutput getOutput();
+  /** Blocks until every line logged so far has been written to the file.*/
+  void flush();
+
+  static void decode(const string& path, std::ostream& out);
+
+  /** fork() doesn't copy the writer thread, so it must be stopped before forking, after writing out what
+      was logged. The parent then restarts it. The child can't share the file with the parent, so its lines
+      are dropped.*/
+  static void prepareFork();
+  static void afterFork(bool inChild);
+
+  private:
+  void push(string& line);
+  bool writeNext();
+  void writerLoop();
+  void startWriter();
+  void stopWriter();
+
+  struct Slot {
+    atomic<size_t> sequence;
+    string line;
+    long long time;
+    int threadIndex;
+  };
+  static constexpr size_t numSlots = 1 << 14;
+  unique_ptr<Slot[]> slots;
+  atomic<size_t> enqueuePos;
+  atomic<size_t> numWritten;
+  size_t dequeuePos = 0;
+  atomic<bool> finished;
+  atomic<bool> flushRequested;
+  atomic<bool> disabled;
+  steady_clock::time_point startTime;
+  long long lastTime = 0;
+  unique_ptr<ogzstream> file;
+  thread writer;
+};
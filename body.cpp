@@ -87,6 +87,7 @@ Body Body::nonHumanoidSpirit(Size s) {
 }
 
 void Body::addWithoutUpdatingPermanentEffects(BodyPart part, int cnt) {
+  epoch.bump();
   bodyParts[part] += cnt;
 }
 
@@ -95,10 +96,12 @@ void Body::setWeight(double w) {
 }
 
 void Body::setSize(BodySize s) {
+  epoch.bump();
   size = s;
 }
 
 void Body::setBodyParts(const EnumMap<BodyPart, int>& p) {
+  epoch.bump();
   bodyParts = p;
   bodyParts[BodyPart::TORSO] = 1;
   bodyParts[BodyPart::BACK] = 1;
@@ -266,10 +269,12 @@ int Body::numGood(BodyPart part) const {
 }
 
 void Body::clearInjured(BodyPart part) {
+  epoch.bump();
   injuredBodyParts[part] = 0;
 }
 
 void Body::clearLost(BodyPart part) {
+  epoch.bump();
   bodyParts[part] += lostBodyParts[part];
   lostBodyParts[part] = 0;
 }
@@ -388,6 +393,7 @@ void consumeBodyAttr(T& mine, const T& his, vector<string>& adjectives, const st
 }
 
 void Body::consumeBodyParts(Creature* c, Body& other, vector<string>& adjectives) {
+  epoch.bump();
   for (BodyPart part : ENUM_ALL(BodyPart)) {
     int cnt = other.bodyParts[part] - bodyParts[part];
     if (cnt > 0) {
@@ -413,6 +419,7 @@ void Body::consumeBodyParts(Creature* c, Body& other, vector<string>& adjectives
 
 
 bool Body::looseBodyPart(BodyPart part) {
+  epoch.bump();
   if (bodyParts[part] > 0) {
     --bodyParts[part];
     ++lostBodyParts[part];
@@ -423,6 +430,7 @@ bool Body::looseBodyPart(BodyPart part) {
 }
 
 bool Body::injureBodyPart(BodyPart part) {
+  epoch.bump();
   if (injuredBodyParts[part] < bodyParts[part])
     ++injuredBodyParts[part];
   return isCritical(part);
@@ -1003,6 +1011,10 @@ double Body::getBoulderDamage() const {
   }
 }
 
+long long Body::getEpoch() const {
+  return epoch.get();
+}
+
 int Body::getCarryLimit() const {
   switch (size) {
     case Body::Size::HUGE: return 200;
@@ -7,6 +7,7 @@
 #include "item_type.h"
 #include "body_part.h"
 #include "intrinsic_attack.h"
+#include "memo.h"
 
 #undef HUGE
 
@@ -129,6 +130,8 @@ class Body {
 
   bool isUndead() const;
   double getBoulderDamage() const;
+  /** Changes whenever body parts are injured, lost or gained, or the size changes.*/
+  long long getEpoch() const;
 
   SERIALIZATION_DECL(Body)
   template <class Archive>
@@ -167,5 +170,6 @@ class Body {
   void dropUnsupportedEquipment(const Creature*) const;
   vector<pair<optional<ItemType>, double>> SERIAL(drops);
   optional<bool> SERIAL(canCapture);
+  DirtyEpoch epoch;
 };
 
@@ -20,6 +20,17 @@ class CallCache {
       return insertValue(key, gen(std::forward<Args>(args)...));
   }
 
+  /** Like get(), but the key is made of the stamps instead of the generator's arguments, so that big
+      arguments don't have to be hashed. The stamps must change whenever the generated value would.*/
+  template <typename Generator, typename... Stamps>
+  Value getStamped(Generator gen, int id, const Stamps&...stamps) {
+    Key key = {id, combineHash(stamps...)};
+    if (auto elem = getValue(key))
+      return *elem;
+    else
+      return insertValue(key, gen());
+  }
+
   int getSize() const {
     return cache.size();
   }
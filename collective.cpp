@@ -51,6 +51,7 @@
 #include "quarters.h"
 #include "position_matching.h"
 #include "storage_id.h"
+#include "inventory.h"
 #include "game_config.h"
 #include "conquer_condition.h"
 #include "game_event.h"
@@ -202,6 +203,7 @@ void Collective::removeCreature(Creature* c) {
     if (group.size() == 0)
       populationGroups.removeElement(group);
   returnResource(taskMap->freeFromTask(c));
+  minionEquipment->removeOwner(c);
   for (auto team : teams->getContaining(c))
     teams->remove(team, c);
   for (MinionTrait t : ENUM_ALL(MinionTrait))
@@ -600,6 +602,7 @@ void Collective::onEvent(const GameEvent& event) {
       },
       [&](const MovementChanged& info) {
         positionMatching->updateMovement(info.pos);
+        territory->updateMovement(info.pos);
       },
       [&](const FurnitureDestroyed& info) {
         if (info.position.getModel() == model) {
@@ -710,8 +713,25 @@ GlobalTime Collective::getGlobalTime() const {
   return getGame()->getGlobalTime();
 }
 
-int Collective::numResource(ResourceId id) const {
-  int ret = credit[id];
+static bool checkCachedCounts = false;
+
+void Collective::setCheckCachedCounts(bool value) {
+  checkCachedCounts = value;
+}
+
+long long Collective::getStorageEpoch(StorageId storage) const {
+  switch (storage) {
+    case StorageId::RESOURCE:
+    case StorageId::EQUIPMENT:
+      return zones->getEpoch();
+    case StorageId::GOLD:
+    case StorageId::CORPSES:
+      return constructions->getBuiltEpoch();
+  }
+}
+
+int Collective::countStoredResource(ResourceId id) const {
+  int ret = 0;
   if (auto itemIndex = config->getResourceInfo(id).itemIndex)
     if (auto storage = config->getResourceInfo(id).storageId)
       for (auto& pos : getStoragePositions(*storage))
@@ -719,6 +739,20 @@ int Collective::numResource(ResourceId id) const {
   return ret;
 }
 
+int Collective::numResource(ResourceId id) const {
+  int ret = credit[id];
+  if (auto storage = config->getResourceInfo(id).storageId) {
+    static MemoStats stats("Collective::numResource");
+    int stored = storedResourceCount[id].get({Inventory::getChangeEpoch(), getStorageEpoch(*storage)}, stats,
+        [&] { return countStoredResource(id); });
+    if (checkCachedCounts)
+      CHECK(stored == countStoredResource(id)) << "Cached count of " << config->getResourceInfo(id).name
+          << " is " << stored << " instead of " << countStoredResource(id);
+    ret += stored;
+  }
+  return ret;
+}
+
 int Collective::numResourcePlusDebt(ResourceId id) const {
   return numResource(id) - getDebt(id);
 }
@@ -821,10 +855,20 @@ vector<Item*> Collective::getAllItemsImpl(optional<ItemIndex> index, bool includ
   return allItems;
 }
 
-int Collective::getNumItems(ItemIndex index, bool includeMinions) const {
+int Collective::countTerritoryItems(ItemIndex index) const {
   int ret = 0;
   for (Position v : territory->getAll())
     ret += v.getItems(index).size();
+  return ret;
+}
+
+int Collective::getNumItems(ItemIndex index, bool includeMinions) const {
+  static MemoStats stats("Collective::getNumItems");
+  int ret = territoryItemCount[index].get({Inventory::getChangeEpoch(), territory->getEpoch()}, stats,
+      [&] { return countTerritoryItems(index); });
+  if (checkCachedCounts)
+    CHECK(ret == countTerritoryItems(index)) << "Cached count of " << ::getName(index) << " is " << ret
+        << " instead of " << countTerritoryItems(index);
   if (includeMinions)
     for (Creature* c : getCreatures())
       ret += c->getEquipment().getItems(index).size();
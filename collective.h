@@ -23,6 +23,8 @@
 #include "minion_trait.h"
 #include "dungeon_level.h"
 #include "enemy_id.h"
+#include "item_index.h"
+#include "memo.h"
 
 class CollectiveAttack;
 class Creature;
@@ -120,6 +122,8 @@ class Collective : public TaskCallback, public UniqueEntity<Collective>, public
 
   int numResource(ResourceId) const;
   int numResourcePlusDebt(ResourceId) const;
+  /** Makes numResource and getNumItems compare every cached count with a full scan.*/
+  static void setCheckCachedCounts(bool);
   bool hasResource(const CostInfo&) const;
   void takeResource(const CostInfo&);
   void returnResource(const CostInfo&);
@@ -307,6 +311,13 @@ class Collective : public TaskCallback, public UniqueEntity<Collective>, public
   DungeonLevel SERIAL(dungeonLevel);
   bool SERIAL(hadALeader) = false;
   vector<Item*> getAllItemsImpl(optional<ItemIndex>, bool includeMinions) const;
+  // Item counts in storage and territory, valid until an inventory, the storage positions or the territory change.
+  long long getStorageEpoch(StorageId) const;
+  int countStoredResource(ResourceId) const;
+  int countTerritoryItems(ItemIndex) const;
+  using CountKey = pair<long long, long long>;
+  mutable EnumMap<ResourceId, Memo<CountKey, int>> storedResourceCount;
+  mutable EnumMap<ItemIndex, Memo<CountKey, int>> territoryItemCount;
   // Remove after alpha 27
   void updateBorderTiles();
   bool updatedBorderTiles = false;
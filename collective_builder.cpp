@@ -117,3 +117,14 @@ PCollective CollectiveBuilder::build(const ContentFactory* contentFactory) const
 bool CollectiveBuilder::hasCreatures() const {
   return !creatures.empty();
 }
+
+CollectiveBuilder::Checkpoint CollectiveBuilder::checkpoint() const {
+  return Checkpoint{(int) creatures.size(), (int) squares.size(), centralPoint};
+}
+
+void CollectiveBuilder::restore(const Checkpoint& checkpoint) {
+  CHECK(creatures.size() >= checkpoint.numCreatures && squares.size() >= checkpoint.numSquares);
+  creatures.resize(checkpoint.numCreatures);
+  squares.resize(checkpoint.numSquares);
+  centralPoint = checkpoint.centralPoint;
+}
@@ -31,6 +31,15 @@ class CollectiveBuilder {
   PCollective build(const ContentFactory*) const;
   bool hasCreatures() const;
 
+  /** Used by LevelBuilder to undo changes done by a failed level maker.*/
+  struct Checkpoint {
+    int numCreatures;
+    int numSquares;
+    optional<Vec2> centralPoint;
+  };
+  Checkpoint checkpoint() const;
+  void restore(const Checkpoint&);
+
   private:
   optional<CollectiveName> getCollectiveName();
   WModel model = nullptr;
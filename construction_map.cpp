@@ -7,6 +7,7 @@
 #include "task.h"
 #include "game.h"
 #include "content_factory.h"
+#include "memory_report.h"
 
 SERIALIZATION_CONSTRUCTOR_IMPL2(ConstructionMap::FurnitureInfo, FurnitureInfo);
 
@@ -81,6 +82,7 @@ void ConstructionMap::onFurnitureDestroyed(Position pos, FurnitureLayer layer) {
   if (auto info = furniture[layer].getReferenceMaybe(pos)) {
     addDebt(info->getCost());
     furniturePositions[info->getFurnitureType()].erase(pos);
+    builtEpoch.bump();
     info->reset();
   }
 }
@@ -90,9 +92,10 @@ void ConstructionMap::addFurniture(Position pos, const FurnitureInfo& info, Furn
   allFurniture.push_back({pos, layer});
   furniture[layer].set(pos, info);
   pos.setNeedsRenderAndMemoryUpdate(true);
-  if (info.isBuilt(pos, layer))
+  if (info.isBuilt(pos, layer)) {
     furniturePositions[info.getFurnitureType()].insert(pos);
-  else {
+    builtEpoch.bump();
+  } else {
     ++unbuiltCounts[info.getFurnitureType()];
     addDebt(info.getCost());
   }
@@ -118,6 +121,10 @@ const PositionSet& ConstructionMap::getBuiltPositions(FurnitureType type) const
     return empty;
 }
 
+long long ConstructionMap::getBuiltEpoch() const {
+  return builtEpoch.get();
+}
+
 const vector<pair<Position, FurnitureLayer>>& ConstructionMap::getAllFurniture() const {
   return allFurniture;
 }
@@ -127,6 +134,7 @@ void ConstructionMap::onConstructed(Position pos, FurnitureType type) {
   if (!containsFurniture(pos, layer))
     addFurniture(pos, FurnitureInfo::getBuilt(type), layer);
   furniturePositions[type].insert(pos);
+  builtEpoch.bump();
   --unbuiltCounts[type];
   if (furniture[layer].contains(pos)) { // why this if?
     auto& info = furniture[layer].getOrInit(pos);
@@ -216,3 +224,13 @@ void ConstructionMap::serialize(Archive& ar, const unsigned int version) {
 }
 
 SERIALIZABLE(ConstructionMap);
+
+void ConstructionMap::reportMemory(MemoryReport& report) const {
+  for (auto layer : ENUM_ALL(FurnitureLayer))
+    furniture[layer].reportMemory(report);
+  traps.reportMemory(report);
+  for (auto& elem : furniturePositions)
+    report.addNodes(elem.second);
+  report.addVector(allFurniture);
+  report.addVector(allTraps);
+}
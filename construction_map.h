@@ -8,6 +8,7 @@
 #include "furniture_layer.h"
 #include "resource_id.h"
 #include "position_map.h"
+#include "memo.h"
 
 class ConstructionMap {
   public:
@@ -61,6 +62,8 @@ class ConstructionMap {
   int getBuiltCount(FurnitureType) const;
   int getTotalCount(FurnitureType) const;
   const PositionSet& getBuiltPositions(FurnitureType) const;
+  /** Changes whenever the built positions of any furniture type change.*/
+  long long getBuiltEpoch() const;
   void onConstructed(Position, FurnitureType);
   void clearUnsupportedFurniturePlans();
 
@@ -73,6 +76,7 @@ class ConstructionMap {
   const vector<pair<Position, FurnitureLayer>>& getAllFurniture() const;
   const vector<Position>& getAllTraps() const;
   int getDebt(CollectiveResourceId) const;
+  void reportMemory(MemoryReport&) const;
 
   template <class Archive>
   void serialize(Archive& ar, const unsigned int version);
@@ -85,5 +89,6 @@ class ConstructionMap {
   PositionMap<TrapInfo> SERIAL(traps);
   vector<Position> SERIAL(allTraps);
   EnumMap<CollectiveResourceId, int> SERIAL(debt);
+  DirtyEpoch builtEpoch;
   void addDebt(const CostInfo&);
 };
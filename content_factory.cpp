@@ -287,4 +287,5 @@ const CreatureFactory& ContentFactory::getCreatures() const {
 
 ContentFactory::ContentFactory() {}
 ContentFactory::~ContentFactory() {}
+ContentFactory::ContentFactory(const ContentFactory&) = default;
 ContentFactory::ContentFactory(ContentFactory&&) = default;
@@ -44,6 +44,7 @@ class ContentFactory {
 
   ContentFactory();
   ~ContentFactory();
+  ContentFactory(const ContentFactory&);
   ContentFactory(ContentFactory&&);
 
   template <class Archive>
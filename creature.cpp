@@ -117,6 +117,7 @@ void Creature::setAlternativeViewId(optional<ViewId> id) {
     modViewObject().setId(*primaryViewId);
     primaryViewId = none;
   }
+  statsEpoch.bump();
 }
 
 bool Creature::hasAlternativeViewId() const {
@@ -419,6 +420,8 @@ void Creature::you(const string& param) const {
 }
 
 void Creature::verb(const string& second, const string& third, const string& param) const {
+  if (!getController()->getMessageGenerator().hasAudience(this))
+    return;
   secondPerson("You "_s + second + (param.empty() ? "" : " " + param));
   thirdPerson(getName().the() + " " + third + (param.empty() ? "" : " " + param));
 }
@@ -427,6 +430,10 @@ void Creature::secondPerson(const PlayerMessage& message) const {
   getController()->getMessageGenerator().addSecondPerson(this, message);
 }
 
+void Creature::secondPerson(const function<PlayerMessage()>& message) const {
+  getController()->getMessageGenerator().addSecondPerson(this, message);
+}
+
 WController Creature::getController() const {
   if (!controllerStack.empty())
     return controllerStack.back().get();
@@ -534,6 +541,10 @@ void Creature::thirdPerson(const PlayerMessage& playerCanSee) const {
   getController()->getMessageGenerator().addThirdPerson(this, playerCanSee);
 }
 
+void Creature::thirdPerson(const function<PlayerMessage()>& playerCanSee) const {
+  getController()->getMessageGenerator().addThirdPerson(this, playerCanSee);
+}
+
 vector<Item*> Creature::getPickUpOptions() const {
   if (!getBody().isHumanoid())
     return vector<Item*>();
@@ -587,8 +598,8 @@ CreatureAction Creature::pickUp(const vector<Item*>& itemsAll) const {
   return CreatureAction(this, [=](Creature* self) {
     INFO << getName().the() << " pickup ";
     for (auto stack : stackItems(items)) {
-      thirdPerson(getName().the() + " picks up " + getPluralAName(stack[0], stack.size()));
-      secondPerson("You pick up " + getPluralTheName(stack[0], stack.size()));
+      thirdPerson([&] { return getName().the() + " picks up " + getPluralAName(stack[0], stack.size()); });
+      secondPerson([&] { return "You pick up " + getPluralTheName(stack[0], stack.size()); });
     }
     self->equipment->addItems(self->getPosition().removeItems(items), self);
     if (!isAffected(LastingEffect::NO_CARRY_LIMIT) &&
@@ -609,8 +620,8 @@ CreatureAction Creature::drop(const vector<Item*>& items) const {
   return CreatureAction(this, [=](Creature* self) {
     INFO << getName().the() << " drop";
     for (auto stack : stackItems(items)) {
-      thirdPerson(getName().the() + " drops " + getPluralAName(stack[0], stack.size()));
-      secondPerson("You drop " + getPluralTheName(stack[0], stack.size()));
+      thirdPerson([&] { return getName().the() + " drops " + getPluralAName(stack[0], stack.size()); });
+      secondPerson([&] { return "You drop " + getPluralTheName(stack[0], stack.size()); });
     }
     getGame()->addEvent(EventInfo::ItemsDropped{self, items});
     self->getPosition().dropItems(self->equipment->removeItems(items, self));
@@ -685,8 +696,8 @@ CreatureAction Creature::equip(Item* item) const {
       Item* previousItem = self->equipment->getSlotItems(slot)[0];
       self->equipment->unequip(previousItem, self);
     }
-    secondPerson("You equip " + item->getTheName(false, self));
-    thirdPerson(getName().the() + " equips " + item->getAName());
+    secondPerson([&] { return "You equip " + item->getTheName(false, self); });
+    thirdPerson([&] { return getName().the() + " equips " + item->getAName(); });
     self->equipment->equip(item, slot, self);
     if (auto game = getGame())
       game->addEvent(EventInfo::ItemsEquipped{self, {item}});
@@ -705,10 +716,10 @@ CreatureAction Creature::unequip(Item* item) const {
     INFO << getName().the() << " unequip";
     CHECK(equipment->isEquipped(item)) << "Item not equipped.";
     EquipmentSlot slot = item->getEquipmentSlot();
-    secondPerson("You " + string(slot == EquipmentSlot::WEAPON ? " sheathe " : " remove ") +
-        item->getTheName(false, this));
-    thirdPerson(getName().the() + (slot == EquipmentSlot::WEAPON ? " sheathes " : " removes ") +
-        item->getAName());
+    secondPerson([&] { return "You " + string(slot == EquipmentSlot::WEAPON ? " sheathe " : " remove ") +
+        item->getTheName(false, this); });
+    thirdPerson([&] { return getName().the() + (slot == EquipmentSlot::WEAPON ? " sheathes " : " removes ") +
+        item->getAName(); });
     self->equipment->unequip(item, self);
     //self->spendTime();
   });
@@ -777,8 +788,8 @@ CreatureAction Creature::chatTo(Creature* other) const {
   CHECK(other);
   if (other->getPosition().dist8(getPosition()) == 1 && getBody().isHumanoid())
     return CreatureAction(this, [=](Creature* self) {
-        secondPerson("You chat with " + other->getName().the());
-        thirdPerson(getName().the() + " chats with " + other->getName().the());
+        secondPerson([&] { return "You chat with " + other->getName().the(); });
+        thirdPerson([&] { return getName().the() + " chats with " + other->getName().the(); });
         other->getAttributes().chatReaction(other, self);
         self->spendTime();
     });
@@ -791,8 +802,8 @@ CreatureAction Creature::pet(Creature* other) const {
   if (other->getPosition().dist8(getPosition()) == 1 && other->getAttributes().getPetReaction(other) &&
       isFriend(other) && getBody().isHumanoid())
     return CreatureAction(this, [=](Creature* self) {
-        secondPerson("You pet " + other->getName().the());
-        thirdPerson(getName().the() + " pets " + other->getName().the());
+        secondPerson([&] { return "You pet " + other->getName().the(); });
+        thirdPerson([&] { return getName().the() + " pets " + other->getName().the(); });
         self->message(*other->getAttributes().getPetReaction(other));
         self->spendTime();
     });
@@ -907,8 +918,15 @@ int Creature::getAttrBonus(AttrType type, bool includeWeapon) const {
   return def;
 }
 
+Creature::StatsKey Creature::getStatsKey() const {
+  return make_tuple(globalTime, statsEpoch.get(), attributes->getEpoch(), getBody().getEpoch(),
+      equipment->getEquippedEpoch());
+}
+
 int Creature::getAttr(AttrType type, bool includeWeapon) const {
-  return max(0, attributes->getRawAttr(type) + getAttrBonus(type, includeWeapon));
+  static MemoStats stats("Creature::getAttr");
+  return (includeWeapon ? attrWithWeaponMemo : attrMemo)[type].get(getStatsKey(), stats,
+      [&] { return max(0, attributes->getRawAttr(type) + getAttrBonus(type, includeWeapon)); });
 }
 
 int Creature::getPoints() const {
@@ -1497,7 +1515,8 @@ void Creature::increaseExpLevel(ExperienceType type, double increase) {
 }
 
 BestAttack Creature::getBestAttack() const {
-  return BestAttack(this);
+  static MemoStats stats("Creature::getBestAttack");
+  return bestAttack.get(getStatsKey(), stats, [this] { return BestAttack(this); });
 }
 
 CreatureAction Creature::give(Creature* whom, vector<Item*> items) const {
@@ -1602,8 +1621,8 @@ CreatureAction Creature::construct(Vec2 direction, FurnitureType type) const {
 
 CreatureAction Creature::eat(Item* item) const {
   return CreatureAction(this, [=](Creature* self) {
-    thirdPerson(getName().the() + " eats " + item->getAName());
-    secondPerson("You eat " + item->getAName());
+    thirdPerson([&] { return getName().the() + " eats " + item->getAName(); });
+    secondPerson([&] { return "You eat " + item->getAName(); });
     self->addEffect(LastingEffect::SATIATED, 500_visible);
     self->getPosition().removeItem(item);
     self->spendTime(3_visible);
@@ -1614,8 +1633,8 @@ void Creature::destroyImpl(Vec2 direction, const DestroyAction& action) {
   auto pos = getPosition().plus(direction);
   if (auto furniture = pos.modFurniture(FurnitureLayer::MIDDLE)) {
     string name = furniture->getName();
-    secondPerson("You "_s + action.getVerbSecondPerson() + " the " + name);
-    thirdPerson(getName().the() + " " + action.getVerbThirdPerson() + " the " + name);
+    secondPerson([&] { return "You "_s + action.getVerbSecondPerson() + " the " + name; });
+    thirdPerson([&] { return getName().the() + " " + action.getVerbThirdPerson() + " the " + name; });
     pos.unseenMessage(action.getSoundText());
     furniture->tryToDestroyBy(pos, this, action);
   }
@@ -1706,8 +1725,8 @@ CreatureAction Creature::applyItem(Item* item) const {
     return CreatureAction("You have no healthy arms!");
   return CreatureAction(this, [=] (Creature* self) {
       auto time = item->getApplyTime();
-      secondPerson("You " + item->getApplyMsgFirstPerson(self));
-      thirdPerson(getName().the() + " " + item->getApplyMsgThirdPerson(self));
+      secondPerson([&] { return "You " + item->getApplyMsgFirstPerson(self); });
+      thirdPerson([&] { return getName().the() + " " + item->getApplyMsgThirdPerson(self); });
       position.unseenMessage(item->getNoSeeApplyMsg());
       item->apply(self);
       if (item->isDiscarded())
@@ -1739,8 +1758,8 @@ CreatureAction Creature::throwItem(Item* item, Position target, bool isFriendlyA
   return CreatureAction(this, [=](Creature* self) {
     Attack attack(isFriendlyAI ? nullptr : self, Random.choose(getBody().getAttackLevels()),
         item->getWeaponInfo().attackType, damage, AttrType::DAMAGE);
-    secondPerson("You throw " + item->getAName(false, this));
-    thirdPerson(getName().the() + " throws " + item->getAName());
+    secondPerson([&] { return "You throw " + item->getAName(false, this); });
+    thirdPerson([&] { return getName().the() + " throws " + item->getAName(); });
     self->getPosition().throwItem(makeVec(self->equipment->removeItem(item, self)), attack, *dist, target, getVision().getId());
     self->spendTime();
   });
@@ -1808,17 +1827,24 @@ TribeSet Creature::getFriendlyTribes() const {
 
 MovementType Creature::getMovementType() const {
   PROFILE;
-  return MovementType(hasAlternativeViewId() ? TribeSet::getFull() : getFriendlyTribes(), {
-      true,
-      isAffected(LastingEffect::FLYING),
-      isAffected(LastingEffect::SWIMMING_SKILL),
-      getBody().canWade()})
-    .setDestroyActions(EnumSet<DestroyAction::Type>([this](auto t) { return DestroyAction(t).canNavigate(this); }))
-    .setForced(isAffected(LastingEffect::BLIND) || getHoldingCreature() || forceMovement)
-    .setFireResistant(isAffected(LastingEffect::FIRE_RESISTANT))
-    .setSunlightVulnerable(isAffected(LastingEffect::SUNLIGHT_VULNERABLE) && !isAffected(LastingEffect::DARKNESS_SOURCE)
-        && (!getGame() || getGame()->getSunlightInfo().getState() == SunlightState::DAY))
-    .setCanBuildBridge(isAffected(LastingEffect::BRIDGE_BUILDING_SKILL));
+  static MemoStats stats("Creature::getMovementType");
+  auto tribes = hasAlternativeViewId() ? TribeSet::getFull() : getFriendlyTribes();
+  bool isDay = !getGame() || getGame()->getSunlightInfo().getState() == SunlightState::DAY;
+  // The holding creature is looked up among the neighbors, so the move id is part of the key.
+  auto key = make_tuple(getStatsKey(), getCurrentMoveId(), tribes, isDay, forceMovement, holding);
+  return movementType.get(key, stats, [&] {
+    return MovementType(tribes, {
+        true,
+        isAffected(LastingEffect::FLYING),
+        isAffected(LastingEffect::SWIMMING_SKILL),
+        getBody().canWade()})
+      .setDestroyActions(EnumSet<DestroyAction::Type>([this](auto t) { return DestroyAction(t).canNavigate(this); }))
+      .setForced(isAffected(LastingEffect::BLIND) || getHoldingCreature() || forceMovement)
+      .setFireResistant(isAffected(LastingEffect::FIRE_RESISTANT))
+      .setSunlightVulnerable(isAffected(LastingEffect::SUNLIGHT_VULNERABLE) && !isAffected(LastingEffect::DARKNESS_SOURCE)
+          && isDay)
+      .setCanBuildBridge(isAffected(LastingEffect::BRIDGE_BUILDING_SKILL));
+  });
 }
 
 int Creature::getDifficultyPoints() const {
@@ -1964,11 +1990,14 @@ CreatureDebt& Creature::getDebt() {
 }
 
 Creature::MoveId Creature::getCurrentMoveId() const {
-  return {position.getModel()->getMoveCounter(), position.getModel()->getUniqueId()};
+  if (auto model = position.getModel())
+    return {model->getMoveCounter(), model->getUniqueId()};
+  return {-1, -1};
 }
 
 const vector<Creature*>& Creature::getVisibleEnemies() const {
   PROFILE;
+  static MemoStats stats("Creature::getVisibleEnemies");
   auto get = [&] {
     vector<Creature*> ret;
     for (Creature* c : getVisibleCreatures())
@@ -1977,14 +2006,12 @@ const vector<Creature*>& Creature::getVisibleEnemies() const {
       }
     return ret;
   };
-  auto currentMoveId = getCurrentMoveId();
-  if (!visibleEnemies || visibleEnemies->first != currentMoveId)
-    visibleEnemies.emplace(make_pair(currentMoveId, get()));
-  return visibleEnemies->second;
+  return visibleEnemies.get(getCurrentMoveId(), stats, get);
 }
 
 const vector<Creature*>& Creature::getVisibleCreatures() const {
   PROFILE;
+  static MemoStats stats("Creature::getVisibleCreatures");
   auto get = [&] {
     vector<Creature*> ret;
     if (!getGlobalTime())
@@ -2001,10 +2028,7 @@ const vector<Creature*>& Creature::getVisibleCreatures() const {
         }
     return ret;
   };
-  auto currentMoveId = getCurrentMoveId();
-  if (!visibleCreatures || visibleCreatures->first != currentMoveId)
-    visibleCreatures.emplace(make_pair(currentMoveId, get()));
-  return visibleCreatures->second;
+  return visibleCreatures.get(getCurrentMoveId(), stats, get);
 }
 
 bool Creature::shouldAIAttack(const Creature* other) const {
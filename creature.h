@@ -25,10 +25,12 @@
 #include "entity_set.h"
 #include "destroy_action.h"
 #include "best_attack.h"
+#include "attr_type.h"
 #include "msg_type.h"
 #include "game_time.h"
 #include "creature_status.h"
 #include "view_id.h"
+#include "memo.h"
 
 class Skill;
 class Level;
@@ -235,8 +237,11 @@ class Creature : public Renderable, public UniqueEntity<Creature>, public OwnedO
   void you(const string& param) const;
   void verb(const string& second, const string& third, const string& param = "") const;
   void secondPerson(const PlayerMessage&) const;
+  void secondPerson(const function<PlayerMessage()>&) const;
   void thirdPerson(const PlayerMessage& playerCanSee, const PlayerMessage& cant) const;
   void thirdPerson(const PlayerMessage& playerCanSee) const;
+  /** Calls the function to format the message only if a player would receive it.*/
+  void thirdPerson(const function<PlayerMessage()>& playerCanSee) const;
   void message(const PlayerMessage&) const;
   void privateMessage(const PlayerMessage&) const;
   void addFX(const FXInfo&) const;
@@ -296,6 +301,7 @@ class Creature : public Renderable, public UniqueEntity<Creature>, public OwnedO
   void cheatAllSpells();
 
   private:
+  friend class Test;
 
   CreatureAction moveTowards(Position, bool away, NavigationFlags);
   optional<MovementInfo> spendTime(TimeInterval = 1_visible);
@@ -325,8 +331,18 @@ class Creature : public Renderable, public UniqueEntity<Creature>, public OwnedO
   int SERIAL(points) = 0;
   using MoveId = pair<int, LevelId>;
   MoveId getCurrentMoveId() const;
-  mutable optional<pair<MoveId, vector<Creature*>>> visibleEnemies;
-  mutable optional<pair<MoveId, vector<Creature*>>> visibleCreatures;
+  Memo<MoveId, vector<Creature*>> visibleEnemies;
+  Memo<MoveId, vector<Creature*>> visibleCreatures;
+  // Everything that the creature's attributes are derived from: the time, which expires lasting effects,
+  // and the epochs of its own state, attributes, body and equipment.
+  using StatsKey = tuple<optional<GlobalTime>, long long, long long, long long, long long>;
+  StatsKey getStatsKey() const;
+  DirtyEpoch statsEpoch;
+  EnumMap<AttrType, Memo<StatsKey, int>> attrMemo;
+  EnumMap<AttrType, Memo<StatsKey, int>> attrWithWeaponMemo;
+  Memo<StatsKey, BestAttack> bestAttack;
+  using MovementKey = tuple<StatsKey, MoveId, TribeSet, bool, bool, optional<Creature::Id>>;
+  Memo<MovementKey, MovementType> movementType;
   HeapAllocated<Vision> SERIAL(vision);
   bool forceMovement = false;
   optional<CombatIntentInfo> SERIAL(lastCombatIntent);
@@ -50,6 +50,10 @@ bool CreatureAttributes::isInstantPrisoner() const {
   return instantPrisoner;
 }
 
+long long CreatureAttributes::getEpoch() const {
+  return epoch.get();
+}
+
 CreatureAttributes::CreatureAttributes(function<void(CreatureAttributes&)> fun) {
   fun(*this);
   initializeLastingEffects();
@@ -99,10 +103,12 @@ const CreatureName& CreatureAttributes::getName() const {
 }
 
 void CreatureAttributes::increaseBaseAttr(AttrType type, int v) {
+  epoch.bump();
   attr[type] += v;
 }
 
 void CreatureAttributes::setBaseAttr(AttrType type, int v) {
+  epoch.bump();
   attr[type] = v;
 }
 
@@ -154,11 +160,13 @@ void CreatureAttributes::increaseMaxExpLevel(ExperienceType type, int increase)
 }
 
 void CreatureAttributes::increaseExpLevel(ExperienceType type, double increase) {
+  epoch.bump();
   increase = max(0.0, min(increase, (double) maxLevelIncrease[type] - expLevel[type]));
   expLevel[type] += increase;
 }
 
 void CreatureAttributes::addCombatExperience(double v) {
+  epoch.bump();
   combatExperience += v;
   int maxExp = 0;
   for (auto expType : ENUM_ALL(ExperienceType))
@@ -176,6 +184,7 @@ bool CreatureAttributes::isTrainingMaxedOut(ExperienceType type) const {
 }
 
 void CreatureAttributes::increaseBaseExpLevel(ExperienceType type, double increase) {
+  epoch.bump();
   for (auto attrType : getAttrIncreases()[type])
     attr[attrType] += increase;
 }
@@ -213,6 +222,7 @@ string CreatureAttributes::getDescription() const {
 }
 
 void CreatureAttributes::add(BodyPart p, int count) {
+  epoch.bump();
   for (auto effect : ENUM_ALL(LastingEffect))
     if (body->isIntrinsicallyAffected(effect))
       --permanentEffects[effect];
@@ -268,6 +278,7 @@ bool CreatureAttributes::considerTimeout(LastingEffect effect, GlobalTime curren
 }
   
 void CreatureAttributes::addLastingEffect(LastingEffect effect, GlobalTime endTime) {
+  epoch.bump();
   if (lastingEffects[effect] < endTime)
     lastingEffects[effect] = endTime;
 }
@@ -344,6 +355,7 @@ void CreatureAttributes::consumeEffects(const EnumMap<LastingEffect, int>& perma
 }
 
 void CreatureAttributes::consume(Creature* self, CreatureAttributes& other) {
+  epoch.bump();
   INFO << name.bare() << " consume " << other.name.bare();
   self->you(MsgType::CONSUME, other.name.the());
   self->addPersonalEvent(self->getName().a() + " absorbs " + other.name.a());
@@ -399,14 +411,17 @@ bool CreatureAttributes::isAffectedPermanently(LastingEffect effect) const {
 }
 
 void CreatureAttributes::clearLastingEffect(LastingEffect effect) {
+  epoch.bump();
   lastingEffects[effect] = GlobalTime(0);
 }
 
 void CreatureAttributes::addPermanentEffect(LastingEffect effect, int count) {
+  epoch.bump();
   permanentEffects[effect] += count;
 }
 
 void CreatureAttributes::removePermanentEffect(LastingEffect effect, int count) {
+  epoch.bump();
   permanentEffects[effect] -= count;
 }
 
@@ -31,6 +31,7 @@
 #include "spell_id.h"
 #include "creature_id.h"
 #include "spell_school_id.h"
+#include "memo.h"
 
 inline bool isLarger(CreatureSize s1, CreatureSize s2) {
   return int(s1) > int(s2);
@@ -114,6 +115,8 @@ class CreatureAttributes {
   optional<LastingEffect> getHatedByEffect() const;
   void randomize();
   bool isInstantPrisoner() const;
+  /** Changes whenever base attributes, experience or effects change.*/
+  long long getEpoch() const;
 
   friend class ContentFactory;
   friend class CreatureFactory;
@@ -154,4 +157,5 @@ class CreatureAttributes {
   optional<LastingEffect> SERIAL(hatedByEffect);
   bool SERIAL(instantPrisoner) = false;
   void initializeLastingEffects();
+  DirtyEpoch epoch;
 };
@@ -222,6 +222,7 @@ void CreatureFactory::setContentFactory(const ContentFactory* f) const {
   contentFactory = f;
 }
 
+CreatureFactory::CreatureFactory(const CreatureFactory&) = default;
 CreatureFactory::CreatureFactory(CreatureFactory&&) = default;
 CreatureFactory& CreatureFactory::operator =(CreatureFactory&&) = default;
 
@@ -58,7 +58,7 @@ class CreatureFactory {
   CreatureFactory(NameGenerator, map<CreatureId, CreatureAttributes>, map<CreatureId, CreatureInventory>,
       map<SpellSchoolId, SpellSchool>, vector<Spell>);
   ~CreatureFactory();
-  CreatureFactory(const CreatureFactory&) = delete;
+  CreatureFactory(const CreatureFactory&);
   CreatureFactory(CreatureFactory&&);
   CreatureFactory& operator = (CreatureFactory&&);
 
@@ -21,7 +21,14 @@
 #define FATAL FatalLog.get() << "FATAL " << __FILE__ << ":" << __LINE__ << " "
 #define USER_FATAL UserErrorLog.get()
 #define USER_INFO UserInfoLog.get()
-#define INFO InfoLog.get() << __FILE__ << ":" <<  __LINE__ << " "
+// The arguments are only evaluated and formatted if the log has any outputs, and never with NO_INFO_LOG,
+// which lets the compiler drop the logging code altogether. Otherwise they are formatted right away by
+// the logging thread.
+#ifdef NO_INFO_LOG
+#define INFO true ? (void) 0 : DebugLog::Voidify() & InfoLog.get()
+#else
+#define INFO !InfoLog.isEnabled() ? (void) 0 : DebugLog::Voidify() & InfoLog.get() << __FILE__ << ":" <<  __LINE__ << " "
+#endif
 #define CHECK(exp) if (!(exp)) FATAL << ": " << #exp << " is false. "
 #define USER_CHECK(exp) if (!(exp)) USER_FATAL
 //#define CHECKEQ(exp, exp2) if ((exp) != (exp2)) FATAL << __FILE__ << ":" << __LINE__ << ": " << #exp << " = " << #exp2 << " is false. " << exp << " " << exp2
@@ -65,11 +72,21 @@ class DebugOutput {
   static DebugOutput exitProgram();
 
   typedef function<void()> LineEndFun;
-  std::ostream& out;
   LineEndFun onLineEnd;
 
+  std::ostream& getStream() const {
+    return threadStream ? threadStream() : *out;
+  }
+
   private:
-  DebugOutput(std::ostream& o, LineEndFun end) : out(o), onLineEnd(end) {}
+  friend class AsyncLog;
+  typedef std::ostream& (*ThreadStreamFun)();
+  DebugOutput(std::ostream& o, LineEndFun end) : onLineEnd(end), out(&o) {}
+  // Outputs used from many threads at once give every thread its own stream, so that they don't share
+  // its formatting state.
+  DebugOutput(ThreadStreamFun s, LineEndFun end) : onLineEnd(end), threadStream(s) {}
+  std::ostream* out = nullptr;
+  ThreadStreamFun threadStream = nullptr;
 };
 
 class DebugLog {
@@ -83,7 +100,7 @@ class DebugLog {
     template <typename T>
     Logger& operator << (const T& t) {
       for (int i = outputs.size() - 1; i >= 0; --i)
-        outputs[i].out << t;
+        outputs[i].getStream() << t;
       return *this;
     }
     ~Logger() {
@@ -95,7 +112,15 @@ class DebugLog {
     std::vector<DebugOutput>& outputs;
   };
 
+  // Turns the logging expression into void, so that it can be used in a conditional operator.
+  struct Voidify {
+    void operator & (const Logger&) {}
+  };
+
   Logger get();
+  bool isEnabled() const {
+    return !outputs.empty();
+  }
 
   private:
   std::vector<DebugOutput> outputs;
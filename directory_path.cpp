@@ -1,6 +1,7 @@
 #include "stdafx.h"
 #include "directory_path.h"
 #include "file_path.h"
+#include "zip_archive.h"
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <unistd.h>
@@ -9,12 +10,23 @@
 DirectoryPath::DirectoryPath(string p) : path(move(p)) {
 }
 
+DirectoryPath DirectoryPath::inArchive(shared_ptr<ZipArchive> archive) {
+  DirectoryPath ret(archive->getPath());
+  ret.archive = std::move(archive);
+  return ret;
+}
+
 FilePath DirectoryPath::file(const std::string& f) const {
   return FilePath(*this, f);
 }
 
 DirectoryPath DirectoryPath::subdirectory(const std::string& s) const {
-  return DirectoryPath(path + "/" + s);
+  DirectoryPath ret(path + "/" + s);
+  if (archive) {
+    ret.archive = archive;
+    ret.archivePath = archivePath.empty() ? s : archivePath + "/" + s;
+  }
+  return ret;
 }
 
 static bool isDirectory(const string& path) {
@@ -26,11 +38,14 @@ static bool isDirectory(const string& path) {
 }
 
 bool DirectoryPath::exists() const {
+  if (archive)
+    return archive->hasDirectory(archivePath);
   return isDirectory(getPath());
 }
 
 void DirectoryPath::createIfDoesntExist() const {
   if (!exists()) {
+    CHECK(!archive) << "Can't create directory " << path << " in a zip archive";
 #ifndef WINDOWS
     USER_CHECK(!mkdir(path.data(), 0750)) << "Unable to create directory \"" + path + "\": " + strerror(errno);
 #else
@@ -40,6 +55,7 @@ void DirectoryPath::createIfDoesntExist() const {
 }
 
 void DirectoryPath::removeRecursively() const {
+  CHECK(!archive) << "Can't remove directory " << path << " from a zip archive";
   if (exists()) {
     for (auto file : getFiles())
       remove(file.getPath());
@@ -58,6 +74,8 @@ static bool isRegularFile(const string& path) {
 }
 
 vector<FilePath> DirectoryPath::getFiles() const {
+  if (archive)
+    return archive->getFiles(archivePath).transform([&](const string& name) { return file(name); });
   vector<FilePath> ret;
   if (DIR* dir = opendir(path.data())) {
     while (dirent* ent = readdir(dir))
@@ -69,6 +87,8 @@ vector<FilePath> DirectoryPath::getFiles() const {
 }
 
 vector<string> DirectoryPath::getSubDirs() const {
+  if (archive)
+    return archive->getSubDirs(archivePath);
   vector<string> ret;
   if (DIR* dir = opendir(path.data())) {
     while (dirent* ent = readdir(dir))
@@ -118,11 +138,8 @@ optional<string> DirectoryPath::copyFiles(DirectoryPath from, DirectoryPath to,
   for (auto file : from.getFiles())
     file.copyTo(to.file(file.getFileName()));
   if (recursive) {
-    for (auto dir : from.getSubDirs()) {
-      DirectoryPath subTo(string(to.getPath()) + "/" + dir);
-      DirectoryPath subFrom(string(from.getPath()) + "/" + dir);
-      copyFiles(subFrom, subTo, recursive);
-    }
+    for (auto dir : from.getSubDirs())
+      copyFiles(from.subdirectory(dir), to.subdirectory(dir), recursive);
   }
   return none;
 }
@@ -132,5 +149,7 @@ bool DirectoryPath::isAbsolute() const {
 }
 
 DirectoryPath DirectoryPath::absolute() const {
+  if (archive)
+    return *this;
   return DirectoryPath(getAbsolute(path.data()));
 }
@@ -4,6 +4,7 @@
 #include "my_containers.h"
 
 class FilePath;
+class ZipArchive;
 
 bool isAbsolutePath(const char* path);
 string getAbsolute(const char* path);
@@ -11,6 +12,8 @@ string getAbsolute(const char* path);
 class DirectoryPath {
   public:
   explicit DirectoryPath(string);
+  /** The root directory of a zip archive. Paths inside it are read-only and served from memory.*/
+  static DirectoryPath inArchive(shared_ptr<ZipArchive>);
 
   FilePath file(const string&) const;
   DirectoryPath subdirectory(const string& s) const;
@@ -32,6 +35,9 @@ class DirectoryPath {
   friend class FilePath;
   friend ostream& operator << (ostream& d, const DirectoryPath& path);
   string path;
+  shared_ptr<ZipArchive> archive;
+  // Path relative to the root of the archive.
+  string archivePath;
 };
 
 extern ostream& operator <<(ostream& d, const DirectoryPath& path);
@@ -114,7 +114,7 @@ static void enhanceArmor(Creature* c, int mod, const string& msg) {
       if (item->getClass() == ItemClass::ARMOR) {
         c->you(MsgType::YOUR, item->getName() + " " + msg);
         if (item->getModifier(AttrType::DEFENSE) > 0 || mod > 0)
-          item->addModifier(AttrType::DEFENSE, mod);
+          c->getEquipment().addModifier(item, AttrType::DEFENSE, mod);
         return;
       }
 }
@@ -122,7 +122,7 @@ static void enhanceArmor(Creature* c, int mod, const string& msg) {
 static void enhanceWeapon(Creature* c, int mod, const string& msg) {
   if (auto item = c->getFirstWeapon()) {
     c->you(MsgType::YOUR, item->getName() + " " + msg);
-    item->addModifier(item->getWeaponInfo().meleeAttackAttr, mod);
+    c->getEquipment().addModifier(item, item->getWeaponInfo().meleeAttackAttr, mod);
   }
 }
 
@@ -1294,6 +1294,21 @@ EffectAIIntent Effect::shouldAIApply(const Creature* caster, Position pos) const
   );
 }
 
+bool Effect::needsAIVictim() const {
+  return effect->visit(
+      [&] (const Effects::Chain& chain) {
+        for (auto& e : chain.effects)
+          if (!e.needsAIVictim())
+            return false;
+        return true;
+      },
+      [&] (const Effects::Area&) { return false; },
+      [&] (const Effects::CustomArea&) { return false; },
+      [&] (const Effects::Chance& e) { return e.effect->needsAIVictim(); },
+      [&] (const auto&) { return true; }
+  );
+}
+
 static optional<FXInfo> getProjectileFX(LastingEffect effect) {
   switch (effect) {
     default:
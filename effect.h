@@ -52,6 +52,9 @@ class Effect {
   optional<ViewId> getProjectile() const;
 
   EffectAIIntent shouldAIApply(const Creature* caster, Position) const;
+  /** Returns true if shouldAIApply() can only return WANTED for a position with a creature that the caster
+      can see. Positions without one can then be skipped without evaluating the effect.*/
+  bool needsAIVictim() const;
 
   static vector<Creature*> summon(Creature*, CreatureId, int num, optional<TimeInterval> ttl, TimeInterval delay = 0_visible);
   static vector<Creature*> summon(Position, CreatureGroup&, int num, optional<TimeInterval> ttl, TimeInterval delay = 0_visible);
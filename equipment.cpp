@@ -93,6 +93,7 @@ bool Equipment::canEquip(const Item* item, const Creature* c) const {
 }
 
 void Equipment::equip(Item* item, EquipmentSlot slot, Creature* c) {
+  equippedEpoch.bump();
   items[slot].push_back(item);
   equipped.push_back(item);
   item->onEquip(c);
@@ -100,11 +101,19 @@ void Equipment::equip(Item* item, EquipmentSlot slot, Creature* c) {
 }
 
 void Equipment::unequip(Item* item, Creature* c) {
+  equippedEpoch.bump();
   items[item->getEquipmentSlot()].removeElement(item);
   equipped.removeElement(item);
   item->onUnequip(c);
 }
 
+void Equipment::addModifier(Item* item, AttrType type, int value) {
+  CHECK(inventory.hasItem(item));
+  item->addModifier(type, value);
+  if (isEquipped(item))
+    equippedEpoch.bump();
+}
+
 PItem Equipment::removeItem(Item* item, Creature* c) {
   if (isEquipped(item))
     unequip(item, c);
@@ -142,3 +151,7 @@ void Equipment::tick(Position pos) {
 bool Equipment::containsAnyOf(const EntitySet<Item>& items) const {
   return inventory.containsAnyOf(items);
 }
+
+long long Equipment::getEquippedEpoch() const {
+  return equippedEpoch.get();
+}
@@ -17,6 +17,7 @@
 
 #include "inventory.h"
 #include "enums.h"
+#include "memo.h"
 
 RICH_ENUM(EquipmentSlot,
   WEAPON,
@@ -42,6 +43,8 @@ class Equipment {
   bool canEquip(const Item*, const Creature*) const;
   void equip(Item*, EquipmentSlot, Creature*);
   void unequip(Item*, Creature*);
+  /** Use instead of Item::addModifier on carried items, so that the holder's stats are recomputed.*/
+  void addModifier(Item*, AttrType, int value);
   PItem removeItem(Item*, Creature*);
   int getMaxItems(EquipmentSlot, const Creature*) const;
   const vector<Item*>& getAllEquipped() const;
@@ -55,6 +58,8 @@ class Equipment {
   const ItemCounts& getCounts() const;
   void tick(Position);
   bool containsAnyOf(const EntitySet<Item>&) const;
+  /** Changes whenever an item is equipped or unequipped, or an equipped item's modifiers change.*/
+  long long getEquippedEpoch() const;
 
   SERIALIZATION_DECL(Equipment);
 
@@ -64,5 +69,6 @@ class Equipment {
   Inventory SERIAL(inventory);
   EnumMap<EquipmentSlot, vector<Item*>> SERIAL(items);
   vector<Item*> SERIAL(equipped);
+  DirtyEpoch equippedEpoch;
 };
 
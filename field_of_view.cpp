@@ -20,6 +20,7 @@
 #include "square_array.h"
 #include "level.h"
 #include "position.h"
+#include "memory_report.h"
 
 template <class Archive>
 void FieldOfView::serialize(Archive& ar, const unsigned int) {
@@ -59,6 +60,36 @@ void FieldOfView::squareChanged(Vec2 pos) {
     }
 }
 
+void FieldOfView::precompute(const vector<Vec2>& positions, WorkerPool& workers) {
+  PROFILE;
+  set<Vec2> missingSet;
+  for (auto pos : positions)
+    if (pos.inRectangle(visibility.getBounds()) && !visibility[pos])
+      missingSet.insert(pos);
+  vector<Vec2> missing(missingSet.begin(), missingSet.end());
+  // The computation only reads the blocking table, so every thread can work on its own positions.
+  vector<unique_ptr<Visibility>> results(missing.size());
+  const int chunkSize = 8;
+  workers.run((missing.size() + chunkSize - 1) / chunkSize, [&] (int chunk) {
+    for (int i = chunk * chunkSize; i < min<int>(missing.size(), (chunk + 1) * chunkSize); ++i)
+      results[i].reset(new Visibility(level->getBounds(), blocking, missing[i].x, missing[i].y));
+  });
+  for (int i : All(missing))
+    visibility[missing[i]] = std::move(results[i]);
+}
+
+void FieldOfView::reportMemory(MemoryReport& report) const {
+  report.get("blocking").add(blocking.getMemoryBytes());
+  auto& cache = report.get("visibility cache");
+  cache.add(visibility.getMemoryBytes());
+  for (Vec2 v : visibility.getBounds())
+    if (auto& elem = visibility[v]) {
+      cache.add(sizeof(Visibility));
+      cache.addVector(elem->getVisibleTiles());
+      cache.addCount(1);
+    }
+}
+
 void FieldOfView::Visibility::setVisible(Rectangle bounds, int x, int y) {
   if (Vec2(px + x, py + y).inRectangle(bounds) &&
       !visible[x + sightRange][y + sightRange] && x * x + y * y <= sightRange * sightRange) {
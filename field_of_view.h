@@ -19,6 +19,7 @@
 
 class Square;
 class SquareArray;
+class MemoryReport;
 
 class FieldOfView {
   public:
@@ -26,6 +27,9 @@ class FieldOfView {
   bool canSee(Vec2 from, Vec2 to);
   const vector<Vec2>& getVisibleTiles(Vec2 from);
   void squareChanged(Vec2 pos);
+  /** Computes the visibility from the given positions that isn't cached yet on the given workers.*/
+  void precompute(const vector<Vec2>& positions, WorkerPool&);
+  void reportMemory(MemoryReport&) const;
 
   SERIALIZATION_DECL(FieldOfView)
 
@@ -2,6 +2,7 @@
 #include "file_path.h"
 #include "debug.h"
 #include "util.h"
+#include "zip_archive.h"
 #include <sys/types.h>
 #include <sys/stat.h>
 
@@ -18,12 +19,16 @@ const char* FilePath::getFileName() const {
 }
 
 time_t FilePath::getModificationTime() const {
+  if (archive)
+    return archive->getModificationTime(archivePath);
   struct stat buf;
   stat(getPath(), &buf);
   return buf.st_mtime;
 }
 
 bool FilePath::exists() const {
+  if (archive)
+    return archive->hasFile(archivePath);
 #ifdef WINDOWS
   struct _stat buf;
   _stat(fullPath.c_str(), &buf);
@@ -42,12 +47,19 @@ bool FilePath::hasSuffix(const string& suf) const {
 
 FilePath FilePath::changeSuffix(const string& current, const string& newSuf) const {
   CHECK(hasSuffix(current));
-  return FilePath(
+  FilePath ret(
       filename.substr(0, filename.size() - current.size()) + newSuf,
         fullPath.substr(0, fullPath.size() - current.size()) + newSuf);
+  if (archive) {
+    ret.archive = archive;
+    ret.archivePath = archivePath.substr(0, archivePath.size() - current.size()) + newSuf;
+  }
+  return ret;
 }
 
 optional<string> FilePath::readContents() const {
+  if (archive)
+    return archive->readFile(archivePath);
   ifstream in;
   in.open(fullPath);
   if (!in.good())
@@ -57,7 +69,10 @@ optional<string> FilePath::readContents() const {
   return ss.str();
 }
 
-FilePath::FilePath(const DirectoryPath& dir, const string& f) : filename(f), fullPath(dir.getPath() + "/"_s + f) {
+FilePath::FilePath(const DirectoryPath& dir, const string& f) : filename(f), fullPath(dir.getPath() + "/"_s + f),
+    archive(dir.archive) {
+  if (archive)
+    archivePath = dir.archivePath.empty() ? f : dir.archivePath + "/" + f;
 }
 
 FilePath::FilePath(string name, string path) : filename(std::move(name)), fullPath(std::move(path)) {
@@ -76,11 +91,18 @@ bool FilePath::isAbsolute() const {
 }
 
 FilePath FilePath::absolute() const {
+  if (archive)
+    return *this;
   return FilePath::fromFullPath(getAbsolute(fullPath.data()));
 }
 
 void FilePath::copyTo(FilePath to) const {
   CHECK(exists());
+  if (archive) {
+    ofstream out(to.fullPath, std::ios::binary);
+    out << *archive->readFile(archivePath);
+    return;
+  }
   ifstream in(fullPath, std::ios::binary);
   ofstream out(to.fullPath, std::ios::binary);
   out << in.rdbuf();
@@ -27,6 +27,8 @@ class FilePath {
 
   string filename;
   string fullPath;
+  shared_ptr<ZipArchive> archive;
+  string archivePath;
 };
 
 
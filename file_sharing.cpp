@@ -19,7 +19,8 @@
 
 FileSharing::FileSharing(const string& url, const string& modVer, int saveVersion, Options& o, string id)
     : uploadUrl(url), modVersion(modVer), saveVersion(saveVersion), options(o),
-      uploadLoop(bindMethod(&FileSharing::uploadingLoop, this)), installId(id), wasCancelled(false) {
+      uploadLoop(bindMethod(&FileSharing::uploadingLoop, this)), installId(id), wasCancelled(false),
+      batchDownload(false) {
   curl_global_init(CURL_GLOBAL_ALL);
 }
 
@@ -143,6 +144,39 @@ optional<string> FileSharing::downloadSite(const SaveFileInfo& file, const Direc
 #endif
 }
 
+vector<optional<string>> FileSharing::downloadSites(const vector<SaveFileInfo>& files, const DirectoryPath& targetDir,
+    ProgressMeter& meter) {
+#ifdef USE_STEAMWORKS
+  // Steam downloads go through the UGC callbacks, which aren't meant to be driven from several threads.
+  const int maxParallel = 1;
+#else
+  const int maxParallel = 4;
+#endif
+  // Files that don't get started because of a cancel keep this error.
+  vector<optional<string>> ret(files.size(), string("Download cancelled"));
+  atomic<int> nextFile(0);
+  batchDownload = true;
+  auto downloadLoop = [&] {
+    ProgressMeter fileMeter(1);
+    while (!wasCancelled) {
+      int index = nextFile++;
+      if (index >= files.size())
+        break;
+      ret[index] = downloadSite(files[index], targetDir, fileMeter);
+      meter.addProgress();
+    }
+  };
+  vector<thread> threads;
+  for (int i = 1; i < min(maxParallel, files.size()); ++i)
+    threads.push_back(makeThread(downloadLoop));
+  downloadLoop();
+  for (auto& t : threads)
+    t.join();
+  batchDownload = false;
+  consumeCancelled();
+  return ret;
+}
+
 void FileSharing::uploadHighscores(const FilePath& path) {
   if (options.getBoolValue(OptionId::ONLINE))
     uploadQueue.push([this, path] {
@@ -709,6 +743,9 @@ void FileSharing::cancel() {
 }
 
 bool FileSharing::consumeCancelled() {
+  // All downloads of a batch need to see the cancel, so it's cleared only when the batch is done.
+  if (batchDownload)
+    return wasCancelled;
   return wasCancelled.exchange(false);
 }
 
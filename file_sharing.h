@@ -15,6 +15,9 @@ class FileSharing {
   optional<string> uploadSite(const FilePath& path, const string& title, const SavedGameInfo&, ProgressMeter&,
       optional<string>& url);
   optional<string> downloadSite(const SaveFileInfo&, const DirectoryPath& targetDir, ProgressMeter&);
+  /** Downloads a few sites at a time and returns the error of each file, if there was one. Cancelling stops
+      all of the downloads.*/
+  vector<optional<string>> downloadSites(const vector<SaveFileInfo>&, const DirectoryPath& targetDir, ProgressMeter&);
   struct SiteInfo {
     SavedGameInfo gameInfo;
     SaveFileInfo fileInfo;
@@ -67,6 +70,7 @@ class FileSharing {
   optional<string> download(const string& filename, const string& remoteDir, const DirectoryPath& dir, ProgressMeter&);
   string installId;
   atomic<bool> wasCancelled;
+  atomic<bool> batchDownload;
 };
 
 constexpr auto retiredScreenshotFilename = "retired_screenshot.png";
@@ -24,3 +24,16 @@ const optional<FurnitureArray::Construction>& FurnitureArray::getConstruction(Ve
 optional<FurnitureArray::Construction>& FurnitureArray::getConstruction(Vec2 pos, FurnitureLayer layer) {
   return construction[layer][pos];
 }
+
+void FurnitureArray::reclaimReleased() {
+  for (auto layer : ENUM_ALL(FurnitureLayer))
+    built[layer].reclaimReleased();
+}
+
+void FurnitureArray::reportMemory(MemoryReport& report) const {
+  for (auto layer : ENUM_ALL(FurnitureLayer)) {
+    auto& layerReport = report.get(EnumInfo<FurnitureLayer>::getString(layer));
+    built[layer].reportMemory(layerReport);
+    layerReport.get("construction").add(construction[layer].getMemoryBytes());
+  }
+}
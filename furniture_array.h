@@ -26,6 +26,10 @@ class FurnitureArray {
   const optional<Construction>& getConstruction(Vec2, FurnitureLayer) const;
   optional<Construction>& getConstruction(Vec2, FurnitureLayer);
 
+  /** Frees furniture that was removed or replaced. Call only when no furniture code is on the stack.*/
+  void reclaimReleased();
+  void reportMemory(MemoryReport&) const;
+
   SERIALIZATION_DECL(FurnitureArray)
 
   private:
@@ -138,6 +138,13 @@ FurnitureType FurnitureFactory::getWaterType(double depth) const {
 FurnitureFactory::~FurnitureFactory() {
 }
 
+FurnitureFactory::FurnitureFactory(const FurnitureFactory& o) : furnitureLists(o.furnitureLists),
+    trainingFurniture(o.trainingFurniture), upgrades(o.upgrades), needingLight(o.needingLight),
+    bedFurniture(o.bedFurniture), constructionObjects(o.constructionObjects) {
+  for (auto& elem : o.furniture)
+    furniture.emplace(elem.first, makeOwner<Furniture>(*elem.second));
+}
+
 FurnitureFactory::FurnitureFactory(FurnitureFactory&&) = default;
 FurnitureFactory& FurnitureFactory::operator =(FurnitureFactory&&) = default;
 
@@ -41,7 +41,7 @@ class FurnitureFactory {
   vector<FurnitureType> getAllFurnitureType() const;
 
   ~FurnitureFactory();
-  FurnitureFactory(const FurnitureFactory&) = delete;
+  FurnitureFactory(const FurnitureFactory&);
   FurnitureFactory(FurnitureFactory&&);
   FurnitureFactory& operator = (FurnitureFactory&&);
 
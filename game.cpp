@@ -40,6 +40,10 @@
 #include "game_event.h"
 #include "version.h"
 #include "content_factory.h"
+#include "input_queue.h"
+#include "equipment.h"
+#include "zones.h"
+#include "memory_report.h"
 
 template <class Archive> 
 void Game::serialize(Archive& ar, const unsigned int version) {
@@ -183,6 +187,17 @@ vector<WModel> Game::getAllModels() const {
   return ret;
 }
 
+void Game::reportMemory(MemoryReport& report) const {
+  for (auto model : getAllModels())
+    model->reportMemory(report.get("models"));
+  for (auto col : collectives) {
+    col->getConstructions().reportMemory(report.get("collectives").get("constructions"));
+    col->getZones().reportMemory(report.get("collectives").get("zones"));
+  }
+  if (auto control = getPlayerControl())
+    static_cast<const CreatureView*>(control)->getMemory().reportMemory(report.get("map memory"));
+}
+
 bool Game::isSingleModel() const {
   return models.getBounds().getSize() == Vec2(1, 1);
 }
@@ -253,7 +268,7 @@ void Game::doneRetirement() {
 optional<ExitInfo> Game::updateInput() {
   if (spectator)
     while (1) {
-      UserInput input = view->getAction();
+      UserInput input = getAction();
       if (input.getId() == UserInputId::EXIT)
         return ExitInfo(ExitAndQuit());
       if (input.getId() == UserInputId::IDLE)
@@ -261,7 +276,7 @@ optional<ExitInfo> Game::updateInput() {
     }
   if (playerControl && !isTurnBased()) {
     while (1) {
-      UserInput input = view->getAction();
+      UserInput input = getAction();
       if (input.getId() == UserInputId::IDLE)
         break;
       else
@@ -301,6 +316,8 @@ void Game::increaseTime(double diff) {
 
 optional<ExitInfo> Game::update(double timeDiff) {
   ScopeTimer timer("Game::update timer");
+  if (inputQueue)
+    timeDiff = inputQueue->startUpdate(timeDiff, [this] { return getStateHash(); });
   if (auto exitInfo = updateInput())
     return exitInfo;
   considerRealTimeRender();
@@ -356,6 +373,7 @@ bool Game::isVillainActive(WConstCollective col) {
 }
 
 void Game::tick(GlobalTime time) {
+  Profiler::finishInterval(Profiler::Interval::TURN);
   PROFILE_BLOCK("Game::tick");
   if (!turnEvents.empty() && time.getVisibleInt() > *turnEvents.begin()) {
     auto turn = *turnEvents.begin();
@@ -652,6 +670,25 @@ void Game::initialize(Options* o, Highscores* h, View* v, FileSharing* f) {
   fileSharing = f;
 }
 
+void Game::setInputQueue(InputQueue* q) {
+  inputQueue = q;
+}
+
+UserInput Game::getAction() {
+  if (inputQueue)
+    return inputQueue->getAction(view);
+  else
+    return view->getAction();
+}
+
+size_t Game::getStateHash() const {
+  size_t ret = combineHash(currentTime);
+  for (auto model : getAllModels())
+    for (auto c : model->getAllCreatures())
+      ret = combineHash(ret, c->getUniqueId(), c->getPosition(), c->getEquipment().getItems().size());
+  return ret;
+}
+
 const string& Game::getWorldName() const {
   return campaign->getWorldName();
 }
@@ -22,7 +22,10 @@ class SavedGameInfo;
 struct CampaignSetup;
 class AvatarInfo;
 class ContentFactory;
+class MemoryReport;
 class NameGenerator;
+class InputQueue;
+class UserInput;
 
 class Game : public OwnedObject<Game> {
   public:
@@ -34,6 +37,11 @@ class Game : public OwnedObject<Game> {
   Options* getOptions();
   void initialize(Options*, Highscores*, View*, FileSharing*);
   View* getView() const;
+  /** Routes all input reads through the queue, which records or replays them.*/
+  void setInputQueue(InputQueue*);
+  UserInput getAction();
+  /** Returns a hash of the state that recorded sessions are checked against when replayed.*/
+  size_t getStateHash() const;
   ContentFactory* getContentFactory();
   ContentFactory removeContentFactory();
   void exitAction();
@@ -85,6 +93,7 @@ class Game : public OwnedObject<Game> {
   vector<WModel> getAllModels() const;
   bool isSingleModel() const;
   int getSaveProgressCount() const;
+  void reportMemory(MemoryReport&) const;
   WModel getCurrentModel() const;
 
   void prepareSiteRetirement();
@@ -134,6 +143,7 @@ class Game : public OwnedObject<Game> {
   bool wasTransfered = false;
   vector<Creature*> SERIAL(players);
   FileSharing* fileSharing = nullptr;
+  InputQueue* inputQueue = nullptr;
   set<int> SERIAL(turnEvents);
   TimeInterval SERIAL(sunlightTimeOffset);
   friend class GameListener;
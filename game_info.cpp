@@ -217,3 +217,9 @@ vector<AttributeInfo> AttributeInfo::fromCreature(const Creature* c) {
 STRUCT_IMPL(ImmigrantDataInfo)
 ImmigrantDataInfo::ImmigrantDataInfo() {}
 HASH_DEF(ImmigrantDataInfo, requirements, info, name, viewId, attributes, count, timeLeft, id, autoState, cost, generatedTime, keybinding, tutorialHighlight, specialTraits)
+
+void GameInfo::computeStamps() {
+  stamps.playerInfo = combineHash(playerInfo);
+  stamps.villageInfo = combineHash(villageInfo);
+  stamps.tutorial = combineHash(tutorial);
+}
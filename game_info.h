@@ -416,4 +416,14 @@ class GameInfo {
   vector<PlayerMessage> HASH(messageBuffer);
   bool HASH(takingScreenshot) = false;
   HASH_ALL(infoType, time, playerInfo, villageInfo, sunlightInfo, messageBuffer, singleModel, modifiedSquares, totalSquares, tutorial, currentLevel, takingScreenshot)
+
+  /** Hashes of the biggest sections, filled in once per update by computeStamps(). The GUI keys its cached
+      panels on these, so that a section is hashed once rather than once for every panel that shows it.*/
+  struct Stamps {
+    size_t playerInfo = 0;
+    size_t villageInfo = 0;
+    size_t tutorial = 0;
+  };
+  Stamps stamps;
+  void computeStamps();
 };
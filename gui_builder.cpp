@@ -438,7 +438,8 @@ const char* GuiBuilder::getCurrentGameSpeedName() const {
 SGuiElem GuiBuilder::drawRightBandInfo(GameInfo& info) {
   auto getIconHighlight = [&] (Color c) { return gui.topMargin(-1, gui.uiHighlight(c)); };
   auto& collectiveInfo = *info.playerInfo.getReferenceMaybe<CollectiveInfo>();
-  int hash = combineHash(collectiveInfo, info.villageInfo, info.modifiedSquares, info.totalSquares, info.tutorial);
+  int hash = combineHash(info.stamps.playerInfo, info.stamps.villageInfo, info.modifiedSquares, info.totalSquares,
+      info.stamps.tutorial);
   if (hash != rightBandInfoHash) {
     rightBandInfoHash = hash;
     vector<SGuiElem> buttons = makeVec(
@@ -474,8 +475,9 @@ SGuiElem GuiBuilder::drawRightBandInfo(GameInfo& info) {
     }
     vector<pair<CollectiveTab, SGuiElem>> elems = makeVec(
         make_pair(CollectiveTab::MINIONS, drawMinions(collectiveInfo, info.tutorial)),
-        make_pair(CollectiveTab::BUILDINGS, cache->get(bindMethod(
-            &GuiBuilder::drawBuildings, this), THIS_LINE, collectiveInfo, info.tutorial)),
+        make_pair(CollectiveTab::BUILDINGS, cache->getStamped(
+            [&] { return drawBuildings(collectiveInfo, info.tutorial); }, THIS_LINE,
+            info.stamps.playerInfo, info.stamps.tutorial)),
         make_pair(CollectiveTab::KEY_MAPPING, drawKeeperHelp()),
         make_pair(CollectiveTab::TECHNOLOGY, drawTechnology(collectiveInfo))
     );
@@ -2406,44 +2408,45 @@ void GuiBuilder::drawOverlays(vector<OverlayInfo>& ret, GameInfo& info) {
         OverlayInfo::CENTER});
     return;
   }
+  auto& stamps = info.stamps;
   if (info.tutorial)
-    ret.push_back({cache->get(bindMethod(&GuiBuilder::drawTutorialOverlay, this), THIS_LINE,
-         *info.tutorial), OverlayInfo::TUTORIAL});
+    ret.push_back({cache->getStamped([&] { return drawTutorialOverlay(*info.tutorial); }, THIS_LINE,
+         stamps.tutorial), OverlayInfo::TUTORIAL});
   switch (info.infoType) {
     case GameInfo::InfoType::BAND: {
       auto& collectiveInfo = *info.playerInfo.getReferenceMaybe<CollectiveInfo>();
-      ret.push_back({cache->get(bindMethod(&GuiBuilder::drawVillainsOverlay, this), THIS_LINE,
-           info.villageInfo), OverlayInfo::VILLAINS});
-      ret.push_back({cache->get(bindMethod(&GuiBuilder::drawImmigrationOverlay, this), THIS_LINE,
-           collectiveInfo, info.tutorial), OverlayInfo::IMMIGRATION});
+      ret.push_back({cache->getStamped([&] { return drawVillainsOverlay(info.villageInfo); }, THIS_LINE,
+           stamps.villageInfo), OverlayInfo::VILLAINS});
+      ret.push_back({cache->getStamped([&] { return drawImmigrationOverlay(collectiveInfo, info.tutorial); }, THIS_LINE,
+           stamps.playerInfo, stamps.tutorial), OverlayInfo::IMMIGRATION});
       ret.push_back({cache->get(bindMethod(&GuiBuilder::drawRansomOverlay, this), THIS_LINE,
            collectiveInfo.ransom), OverlayInfo::TOP_LEFT});
       ret.push_back({cache->get(bindMethod(&GuiBuilder::drawWarningWindow, this), THIS_LINE,
            collectiveInfo.rebellionChance, collectiveInfo.nextWave), OverlayInfo::TOP_LEFT});
-      ret.push_back({cache->get(bindMethod(&GuiBuilder::drawMinionsOverlay, this), THIS_LINE,
-           collectiveInfo, info.tutorial), OverlayInfo::TOP_LEFT});
-      ret.push_back({cache->get(bindMethod(&GuiBuilder::drawWorkshopsOverlay, this), THIS_LINE,
-           collectiveInfo, info.tutorial), OverlayInfo::TOP_LEFT});
-      ret.push_back({cache->get(bindMethod(&GuiBuilder::drawLibraryOverlay, this), THIS_LINE,
-           collectiveInfo, info.tutorial), OverlayInfo::TOP_LEFT});
-      ret.push_back({cache->get(bindMethod(&GuiBuilder::drawTasksOverlay, this), THIS_LINE,
-           collectiveInfo), OverlayInfo::TOP_LEFT});
-      ret.push_back({cache->get(bindMethod(&GuiBuilder::drawBuildingsOverlay, this), THIS_LINE,
-           collectiveInfo, info.tutorial), OverlayInfo::TOP_LEFT});
+      ret.push_back({cache->getStamped([&] { return drawMinionsOverlay(collectiveInfo, info.tutorial); }, THIS_LINE,
+           stamps.playerInfo, stamps.tutorial), OverlayInfo::TOP_LEFT});
+      ret.push_back({cache->getStamped([&] { return drawWorkshopsOverlay(collectiveInfo, info.tutorial); }, THIS_LINE,
+           stamps.playerInfo, stamps.tutorial), OverlayInfo::TOP_LEFT});
+      ret.push_back({cache->getStamped([&] { return drawLibraryOverlay(collectiveInfo, info.tutorial); }, THIS_LINE,
+           stamps.playerInfo, stamps.tutorial), OverlayInfo::TOP_LEFT});
+      ret.push_back({cache->getStamped([&] { return drawTasksOverlay(collectiveInfo); }, THIS_LINE,
+           stamps.playerInfo), OverlayInfo::TOP_LEFT});
+      ret.push_back({cache->getStamped([&] { return drawBuildingsOverlay(collectiveInfo, info.tutorial); }, THIS_LINE,
+           stamps.playerInfo, stamps.tutorial), OverlayInfo::TOP_LEFT});
       if (bottomWindow == IMMIGRATION_HELP)
-        ret.push_back({cache->get(bindMethod(&GuiBuilder::drawImmigrationHelp, this), THIS_LINE,
-            collectiveInfo), OverlayInfo::BOTTOM_LEFT});
+        ret.push_back({cache->getStamped([&] { return drawImmigrationHelp(collectiveInfo); }, THIS_LINE,
+            stamps.playerInfo), OverlayInfo::BOTTOM_LEFT});
       if (bottomWindow == ALL_VILLAINS)
-        ret.push_back({cache->get(bindMethod(&GuiBuilder::drawAllVillainsOverlay, this), THIS_LINE,
-            info.villageInfo), OverlayInfo::BOTTOM_LEFT});
+        ret.push_back({cache->getStamped([&] { return drawAllVillainsOverlay(info.villageInfo); }, THIS_LINE,
+            stamps.villageInfo), OverlayInfo::BOTTOM_LEFT});
       ret.push_back({cache->get(bindMethod(&GuiBuilder::drawGameSpeedDialog, this), THIS_LINE),
            OverlayInfo::GAME_SPEED});
       break;
     }
     case GameInfo::InfoType::PLAYER: {
       auto& playerInfo = *info.playerInfo.getReferenceMaybe<PlayerInfo>();
-      ret.push_back({cache->get(bindMethod(&GuiBuilder::drawPlayerOverlay, this), THIS_LINE,
-           playerInfo), OverlayInfo::TOP_LEFT});
+      ret.push_back({cache->getStamped([&] { return drawPlayerOverlay(playerInfo); }, THIS_LINE,
+           stamps.playerInfo), OverlayInfo::TOP_LEFT});
       break;
     }
     default:
@@ -16,15 +16,76 @@
 #include "stdafx.h"
 #include "input_queue.h"
 
-void InputQueue::push(UserInput input) {
-  q.push(input);
+#include "view.h"
+
+SERIALIZE_DEF(InputQueue, seed, steps, inputs, checkpoints)
+SERIALIZATION_CONSTRUCTOR_IMPL(InputQueue)
+
+static const int checkpointFreq = 100;
+
+InputQueue InputQueue::record(int seed) {
+  InputQueue ret;
+  ret.seed = seed;
+  return ret;
+}
+
+InputQueue InputQueue::replay(InputQueue recorded) {
+  recorded.replaying = true;
+  return recorded;
+}
+
+int InputQueue::getSeed() const {
+  return seed;
+}
+
+double InputQueue::startUpdate(double timeDiff, function<size_t()> getStateHash) {
+  ++update;
+  numReads = 0;
+  if (update % checkpointFreq == 0) {
+    auto hash = getStateHash();
+    if (!replaying)
+      checkpoints.push_back(Checkpoint{update, hash});
+    else if (nextCheckpoint < checkpoints.size()) {
+      auto& checkpoint = checkpoints[nextCheckpoint++];
+      CHECKEQ(checkpoint.update, update);
+      if (checkpoint.hash != hash && !mismatch)
+        mismatch = update;
+    }
+  }
+  if (!replaying) {
+    steps.push_back(timeDiff);
+    return timeDiff;
+  } else {
+    CHECK(update < steps.size());
+    return steps[update];
+  }
+}
+
+UserInput InputQueue::getAction(View* view) {
+  int read = numReads++;
+  if (!replaying) {
+    auto input = view->getAction();
+    if (input.getId() != UserInputId::IDLE)
+      inputs.push_back(Input{update, read, input});
+    return input;
+  }
+  if (nextInput < inputs.size() && inputs[nextInput].update == update && inputs[nextInput].read == read)
+    return inputs[nextInput++].input;
+  return UserInputId::IDLE;
+}
+
+bool InputQueue::isReplaying() const {
+  return replaying;
+}
+
+bool InputQueue::isFinished() const {
+  return replaying && update + 1 >= steps.size();
 }
 
-bool InputQueue::pop(UserInput& input) {
-  if (q.empty())
-    return false;
-  input = q.front();
-  q.pop();
-  return true;
+int InputQueue::getNumUpdates() const {
+  return steps.size();
 }
 
+optional<int> InputQueue::getMismatch() const {
+  return mismatch;
+}
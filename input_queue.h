@@ -17,11 +17,51 @@
 
 #include "user_input.h"
 
+class View;
+
+/** Records the input that a game reads during its updates, or feeds a recording back instead of the view.
+    A recording keeps the random seed, the time step of every update and every input that wasn't IDLE,
+    stamped with the update and the read that returned it, plus a hash of the game state every few updates.*/
 class InputQueue {
   public:
-  void push(UserInput);
-  bool pop(UserInput&);
+  static InputQueue record(int seed);
+  static InputQueue replay(InputQueue recorded);
+
+  int getSeed() const;
+
+  /** Called at the start of every game update. Returns the time step to use, which is the recorded one
+      when replaying. The state hash is compared or stored at checkpoints.*/
+  double startUpdate(double timeDiff, function<size_t()> getStateHash);
+  UserInput getAction(View*);
+
+  bool isReplaying() const;
+  bool isFinished() const;
+  int getNumUpdates() const;
+  /** Returns the first update at which the replayed game state differed from the recording.*/
+  optional<int> getMismatch() const;
+
+  SERIALIZATION_DECL(InputQueue)
 
   private:
-  queue<UserInput> q;
+  struct Input {
+    int SERIAL(update);
+    int SERIAL(read);
+    UserInput SERIAL(input);
+    SERIALIZE_ALL(update, read, input)
+  };
+  struct Checkpoint {
+    int SERIAL(update);
+    size_t SERIAL(hash);
+    SERIALIZE_ALL(update, hash)
+  };
+  int SERIAL(seed) = 0;
+  vector<double> SERIAL(steps);
+  vector<Input> SERIAL(inputs);
+  vector<Checkpoint> SERIAL(checkpoints);
+  bool replaying = false;
+  int update = -1;
+  int numReads = 0;
+  int nextInput = 0;
+  int nextCheckpoint = 0;
+  optional<int> mismatch;
 };
@@ -23,6 +23,16 @@
 SERIALIZE_DEF(Inventory, items, itemsCache, weight, counts)
 SERIALIZATION_CONSTRUCTOR_IMPL(Inventory);
 
+static atomic<long long> changeEpoch(0);
+
+static void onChanged() {
+  changeEpoch.fetch_add(1, std::memory_order_relaxed);
+}
+
+long long Inventory::getChangeEpoch() {
+  return changeEpoch.load(std::memory_order_relaxed);
+}
+
 void Inventory::addViewId(ViewId id, int count) {
   auto& cur = counts[id];
   if (count > 0 && cur < UINT16_MAX)
@@ -43,6 +53,7 @@ void Inventory::addItem(PItem item) {
       indexes[ind]->insert(item.get());
   weight += item->getWeight();
   items.insert(std::move(item));
+  onChanged();
 }
 
 void Inventory::addItems(vector<PItem> v) {
@@ -58,6 +69,7 @@ PItem Inventory::removeItem(Item* itemRef) {
   for (ItemIndex ind : ENUM_ALL(ItemIndex))
     if (indexes[ind] && hasIndex(ind, item.get()))
       indexes[ind]->remove(itemRef->getUniqueId());
+  onChanged();
   return item;
 }
 
@@ -70,6 +82,7 @@ vector<PItem> Inventory::removeItems(vector<Item*> items) {
 
 void Inventory::clearIndex(ItemIndex ind) {
   indexes[ind] = none;
+  onChanged();
 }
 
 vector<PItem> Inventory::removeAllItems() {
@@ -78,6 +91,7 @@ vector<PItem> Inventory::removeAllItems() {
   for (ItemIndex ind : ENUM_ALL(ItemIndex))
     indexes[ind] = none;
   weight = 0;
+  onChanged();
   return items.removeAll();
 }
 
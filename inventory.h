@@ -51,6 +51,9 @@ class Inventory {
 
   bool isEmpty() const;
 
+  /** Changes whenever any inventory in the game gains or loses an item.*/
+  static long long getChangeEpoch();
+
   SERIALIZATION_DECL(Inventory)
 
   private:
@@ -757,7 +757,7 @@ bool LastingEffects::tick(Creature* c, LastingEffect effect) {
       auto enemyId = [&] ()->optional<ViewId> {
         for (WCollective col : c->getPosition().getModel()->getCollectives())
           if ((col->getTerritory().contains(c->getPosition()) ||
-                 col->getTerritory().getStandardExtended().contains(c->getPosition())) &&
+                 col->getTerritory().isInStandardExtended(c->getPosition())) &&
               col->getTribe()->isEnemy(c) && !col->getCreatures().empty())
             return Random.choose(col->getCreatures())->getViewObject().id();
         return none;
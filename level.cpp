@@ -35,11 +35,16 @@
 #include "square_array.h"
 #include "view_object.h"
 #include "field_of_view.h"
+#include "line_of_fire.h"
 #include "furniture.h"
 #include "furniture_array.h"
 #include "portals.h"
 #include "roof_support.h"
 #include "game_event.h"
+#include "memory_report.h"
+#include "equipment.h"
+#include "body.h"
+#include "item_attributes.h"
 
 template <class Archive> 
 void Level::serialize(Archive& ar, const unsigned int version) {
@@ -408,6 +413,21 @@ bool Level::canSee(Vec2 from, Vec2 to, const Vision& vision) const {
   return isWithinVision(from, to, vision) && getFieldOfView(vision.getId()).canSee(from, to);
 }
 
+bool Level::isLineOfFireObstructed(Vec2 from, Vec2 to, VisionId vision) {
+  if (!lineOfFire)
+    lineOfFire = unique<LineOfFire>(this);
+  return lineOfFire->isObstructed(from, to, vision);
+}
+
+void Level::updateLineOfFire(Vec2 changedSquare) {
+  if (lineOfFire)
+    lineOfFire->squareChanged(changedSquare);
+}
+
+void Level::precomputeVisibility(const vector<Vec2>& positions, VisionId vision, WorkerPool& workers) const {
+  getFieldOfView(vision).precompute(positions, workers);
+}
+
 void Level::moveCreature(Creature* creature, Vec2 direction) {
   Vec2 position = creature->getPosition().getCoord();
   unplaceCreature(creature, position);
@@ -503,6 +523,7 @@ void Level::addTickingFurniture(Vec2 pos) {
 
 void Level::tick() {
   PROFILE_BLOCK("Level::tick");
+  furniture->reclaimReleased();
   for (Vec2 pos : tickingSquares)
     squares->getWritable(pos)->tick(Position(pos, this));
   for (Vec2 pos : tickingFurniture)
@@ -567,6 +588,41 @@ int Level::getNumTotalSquares() const {
   return squares->getNumGenerated();
 }
 
+void Level::reportMemory(MemoryReport& report) const {
+  auto& squaresReport = report.get("squares");
+  squaresReport.add(squares->modified.getMemoryBytes() + squares->getNumGenerated() * sizeof(Square));
+  squaresReport.addCount(squares->getNumGenerated());
+  furniture->reportMemory(report.get("furniture"));
+  auto& tables = report.get("tables");
+  for (auto table : {&memoryUpdates, &renderUpdates, &unavailable, &covered})
+    tables.add(table->getMemoryBytes());
+  for (auto table : {&sunlight, &lightAmount, &lightCapAmount})
+    tables.add(table->getMemoryBytes());
+  for (auto tribe : ENUM_ALL(TribeId::KeyType))
+    if (auto& effects = furnitureEffects[tribe])
+      tables.add(effects->getMemoryBytes());
+  for (auto vision : ENUM_ALL(VisionId))
+    (*fieldOfView)[vision].reportMemory(report.get("field of view").get(EnumInfo<VisionId>::getString(vision)));
+  for (auto& elem : sectors)
+    elem.second.reportMemory(report.get("sectors"));
+  auto& creaturesReport = report.get("creatures");
+  auto& itemsReport = report.get("items");
+  const auto itemSize = sizeof(Item) + sizeof(ItemAttributes);
+  creaturesReport.addVector(creatures);
+  for (auto c : creatures) {
+    creaturesReport.add(sizeof(Creature) + sizeof(CreatureAttributes) + sizeof(Body) + sizeof(Equipment));
+    auto& items = c->getEquipment().getItems();
+    itemsReport.add(items.size() * itemSize);
+    itemsReport.addCount(items.size());
+  }
+  creaturesReport.addCount(creatures.size());
+  for (Vec2 v : getBounds()) {
+    auto& items = getSafeSquare(v)->getInventory().getItems();
+    itemsReport.add(items.size() * itemSize);
+    itemsReport.addCount(items.size());
+  }
+}
+
 void Level::setNeedsMemoryUpdate(Vec2 pos, bool s) {
   if (pos.inRectangle(getBounds()))
     memoryUpdates[pos] = s;
@@ -580,6 +636,10 @@ void Level::setNeedsRenderUpdate(Vec2 pos, bool s) {
   renderUpdates[pos] = s;
 }
 
+void Level::setNeedsRenderUpdate(Rectangle area, bool s) {
+  renderUpdates.fill(area, s);
+}
+
 bool Level::needsMemoryUpdate(Vec2 pos) const {
   return memoryUpdates[pos];
 }
@@ -590,6 +650,8 @@ bool Level::isUnavailable(Vec2 pos) const {
 
 void Level::setFurniture(Vec2 pos, PFurniture f) {
   auto layer = f->getLayer();
+  if (layer == FurnitureLayer::MIDDLE)
+    updateLineOfFire(pos);
   furniture->getConstruction(pos, layer).reset();
   if (f->isTicking())
     addTickingFurniture(pos);
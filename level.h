@@ -24,6 +24,7 @@
 #include "entity_set.h"
 #include "vision_id.h"
 #include "furniture_layer.h"
+#include "tiled_table.h"
 
 class Model;
 class Square;
@@ -42,8 +43,10 @@ class SquareArray;
 class FurnitureArray;
 class Vision;
 class FieldOfView;
+class LineOfFire;
 class Portals;
 class RoofSupport;
+class MemoryReport;
 
 /** A class representing a single level of the dungeon or the overworld. All events occuring on the level are performed by this class.*/
 class Level : public OwnedObject<Level> {
@@ -134,6 +137,11 @@ class Level : public OwnedObject<Level> {
 
   /** Returns if it's possible to see the given square.*/
   bool canSee(Vec2 from, Vec2 to, const Vision&) const;
+  /** Returns true if furniture or a creature on the way stops projectiles fired from 'from' to 'to'.*/
+  bool isLineOfFireObstructed(Vec2 from, Vec2 to, VisionId);
+
+  /** Computes and caches what can be seen from the given positions, on the given workers.*/
+  void precomputeVisibility(const vector<Vec2>& positions, VisionId, WorkerPool&) const;
 
   /** Returns all tiles visible by a creature.*/
   vector<Vec2> getVisibleTiles(Vec2 pos, const Vision&) const;
@@ -159,12 +167,14 @@ class Level : public OwnedObject<Level> {
 
   int getNumGeneratedSquares() const;
   int getNumTotalSquares() const;
+  void reportMemory(MemoryReport&) const;
   bool isUnavailable(Vec2) const;
 
   void setNeedsMemoryUpdate(Vec2, bool);
   bool needsMemoryUpdate(Vec2) const;
   bool needsRenderUpdate(Vec2) const;
   void setNeedsRenderUpdate(Vec2, bool);
+  void setNeedsRenderUpdate(Rectangle, bool);
 
   LevelId getUniqueId() const;
   void setFurniture(Vec2, PFurniture);
@@ -198,12 +208,15 @@ class Level : public OwnedObject<Level> {
   EntitySet<Creature> SERIAL(creatureIds);
   WModel SERIAL(model) = nullptr;
   mutable HeapAllocated<EnumMap<VisionId, FieldOfView>> SERIAL(fieldOfView);
-  Table<double> SERIAL(sunlight);
+  unique_ptr<LineOfFire> lineOfFire;
+  // Light is added and read in a radius around its source, so keep these grids in tiles.
+  typedef TiledTable<double> LightTable;
+  LightTable SERIAL(sunlight);
   Table<bool> SERIAL(covered);
   HeapAllocated<RoofSupport> SERIAL(roofSupport);
   HeapAllocated<CreatureBucketMap> SERIAL(bucketMap);
-  Table<double> SERIAL(lightAmount);
-  Table<double> SERIAL(lightCapAmount);
+  LightTable SERIAL(lightAmount);
+  LightTable SERIAL(lightCapAmount);
   EnumMap<TribeId::KeyType, unique_ptr<EffectsTable>> SERIAL(furnitureEffects);
   mutable unordered_map<MovementType, Sectors, CustomHash<MovementType>> sectors;
   Sectors& getSectorsDontCreate(const MovementType&) const;
@@ -221,6 +234,7 @@ class Level : public OwnedObject<Level> {
   void addLightSource(Vec2 pos, double radius, int numLight);
   void addDarknessSource(Vec2 pos, double radius, int numLight);
   FieldOfView& getFieldOfView(VisionId vision) const;
+  void updateLineOfFire(Vec2 changedSquare);
   const vector<Vec2>& getVisibleTilesNoDarkness(Vec2 pos, VisionId vision) const;
   bool isWithinVision(Vec2 from, Vec2 to, const Vision&) const;
   LevelId SERIAL(levelId) = 0;
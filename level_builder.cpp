@@ -28,6 +28,12 @@ LevelBuilder::LevelBuilder(RandomGen& r, ContentFactory* contentFactory, int wid
 
 LevelBuilder::~LevelBuilder() {}
 
+template <typename Fun>
+void LevelBuilder::journal(Fun undo) {
+  if (numCheckpoints > 0)
+    undoJournal.push_back(std::move(undo));
+}
+
 LevelBuilder::LevelBuilder(LevelBuilder&&) = default;
 
 RandomGen& LevelBuilder::getRandom() {
@@ -43,12 +49,20 @@ bool LevelBuilder::hasAttrib(Vec2 posT, SquareAttrib attr) {
   return attrib[pos].contains(attr);
 }
 
-void LevelBuilder::addAttrib(Vec2 pos, SquareAttrib attr) {
-  attrib[transform(pos)].insert(attr);
+void LevelBuilder::addAttrib(Vec2 posT, SquareAttrib attr) {
+  Vec2 pos = transform(posT);
+  if (!attrib[pos].contains(attr)) {
+    journal([=] { attrib[pos].erase(attr); });
+    attrib[pos].insert(attr);
+  }
 }
 
-void LevelBuilder::removeAttrib(Vec2 pos, SquareAttrib attr) {
-  attrib[transform(pos)].erase(attr);
+void LevelBuilder::removeAttrib(Vec2 posT, SquareAttrib attr) {
+  Vec2 pos = transform(posT);
+  if (attrib[pos].contains(attr)) {
+    journal([=] { attrib[pos].insert(attr); });
+    attrib[pos].erase(attr);
+  }
 }
 
 WSquare LevelBuilder::modSquare(Vec2 pos) {
@@ -64,12 +78,17 @@ vector<Vec2> LevelBuilder::toGlobalCoordinates(vector<Vec2> v) {
 }
 
 void LevelBuilder::addCollective(CollectiveBuilder* col) {
-  if (!collectives.contains(col))
+  if (!collectives.contains(col)) {
+    journalCollective(col);
+    journal([=] { collectives.pop_back(); });
     collectives.push_back(col);
+  }
 }
 
-void LevelBuilder::setHeightMap(Vec2 pos, double h) {
-  heightMap[transform(pos)] = h;
+void LevelBuilder::setHeightMap(Vec2 posT, double h) {
+  Vec2 pos = transform(posT);
+  journal([=, prev = heightMap[pos]] { heightMap[pos] = prev; });
+  heightMap[pos] = h;
 }
 
 double LevelBuilder::getHeightMap(Vec2 pos) {
@@ -77,12 +96,15 @@ double LevelBuilder::getHeightMap(Vec2 pos) {
 }
 
 void LevelBuilder::putCreature(Vec2 pos, PCreature creature) {
+  journal([=] { creatures.pop_back(); });
   creatures.emplace_back(std::move(creature), transform(pos));
 }
 
 void LevelBuilder::putItems(Vec2 posT, vector<PItem> it) {
   CHECK(canPutItems(posT));
   Vec2 pos = transform(posT);
+  int prevSize = items[pos].size();
+  journal([=] { items[pos].resize(prevSize); });
   append(items[pos], std::move(it));
 }
 
@@ -99,6 +121,7 @@ void LevelBuilder::putFurniture(Vec2 posT, FurnitureParams f, optional<SquareAtt
   auto layer = contentFactory->furniture.getData(f.type).getLayer();
   if (getFurniture(posT, layer))
     removeFurniture(posT, layer);
+  journalFurniture(transform(posT), layer);
   furniture.getBuilt(layer).putElem(transform(posT), f, [&](const FurnitureParams& t) {
     return contentFactory->furniture.getFurniture(t.type, t.tribe); });
   if (attrib)
@@ -131,6 +154,7 @@ bool LevelBuilder::canPutFurniture(Vec2 posT, FurnitureLayer layer) {
 
 void LevelBuilder::removeFurniture(Vec2 pos, FurnitureLayer layer) {
   CHECK(getFurnitureType(pos, layer) != FurnitureType("DOWN_STAIRS"));
+  journalFurniture(transform(pos), layer);
   furniture.getBuilt(layer).clearElem(transform(pos));
 }
 
@@ -156,6 +180,7 @@ WConstFurniture LevelBuilder::getFurniture(Vec2 posT, FurnitureLayer layer) {
 
 void LevelBuilder::setLandingLink(Vec2 posT, StairKey key) {
   Vec2 pos = transform(posT);
+  journal([=, prev = squares.getReadonly(pos)->getLandingLink()] { squares.getWritable(pos)->setLandingLink(prev); });
   squares.getWritable(pos)->setLandingLink(key);
 }
 
@@ -171,6 +196,7 @@ bool LevelBuilder::canPutCreature(Vec2 posT, Creature* c) {
 }
 
 void LevelBuilder::setNoDiagonalPassing() {
+  journal([=, prev = noDiagonalPassing] { noDiagonalPassing = prev; });
   noDiagonalPassing = true;
 }
 
@@ -239,19 +265,30 @@ Vec2 LevelBuilder::transform(Vec2 v) {
 }
 
 void LevelBuilder::setCovered(Vec2 posT, bool state) {
-  covered[transform(posT)] = state;
+  Vec2 pos = transform(posT);
+  journal([=, prev = bool(covered[pos])] { covered[pos] = prev; });
+  covered[pos] = state;
+}
+
+bool LevelBuilder::isCovered(Vec2 pos) {
+  return covered[transform(pos)];
 }
 
 void LevelBuilder::setBuilding(Vec2 posT, bool state) {
-  building[transform(posT)] = state;
+  Vec2 pos = transform(posT);
+  journal([=, prev = bool(building[pos])] { building[pos] = prev; });
+  building[pos] = state;
 }
 
 void LevelBuilder::setSunlight(Vec2 pos, double s) {
+  journal([=, prev = sunlight[pos]] { sunlight[pos] = prev; });
   sunlight[pos] = s;
 }
 
-void LevelBuilder::setUnavailable(Vec2 pos) {
-  unavailable[transform(pos)] = true;
+void LevelBuilder::setUnavailable(Vec2 posT) {
+  Vec2 pos = transform(posT);
+  journal([=, prev = bool(unavailable[pos])] { unavailable[pos] = prev; });
+  unavailable[pos] = true;
 }
 
 bool LevelBuilder::canNavigate(Vec2 posT, const MovementType& movement) {
@@ -270,3 +307,64 @@ bool LevelBuilder::canNavigate(Vec2 posT, const MovementType& movement) {
   return result;
 
 }
+
+void LevelBuilder::journalFurniture(Vec2 pos, FurnitureLayer layer) {
+  journal([=, prev = furniture.getBuilt(layer).getParam(pos)] {
+    if (prev)
+      furniture.getBuilt(layer).putElem(pos, *prev, [&](const FurnitureParams& t) {
+        return contentFactory->furniture.getFurniture(t.type, t.tribe); });
+    else
+      furniture.getBuilt(layer).clearElem(pos);
+  });
+}
+
+void LevelBuilder::journalCollective(CollectiveBuilder* col) {
+  journal([col, prev = col->checkpoint()] { col->restore(prev); });
+}
+
+LevelBuilder::Checkpoint LevelBuilder::checkpoint() {
+  ++numCheckpoints;
+  // Makers modify collectives directly, so remember the state of every collective added so far.
+  for (auto col : collectives)
+    journalCollective(col);
+  return Checkpoint{(int) undoJournal.size()};
+}
+
+void LevelBuilder::restore(Checkpoint c) {
+  CHECK(numCheckpoints > 0);
+  CHECK(undoJournal.size() >= c.journalSize);
+  while (undoJournal.size() > c.journalSize) {
+    undoJournal.back()();
+    undoJournal.pop_back();
+  }
+  release(c);
+}
+
+void LevelBuilder::release(Checkpoint) {
+  CHECK(numCheckpoints > 0);
+  if (--numCheckpoints == 0)
+    undoJournal.clear();
+}
+
+void LevelBuilder::setStats(LevelGenStats* s) {
+  stats = s;
+}
+
+LevelGenStats* LevelBuilder::getStats() const {
+  return stats;
+}
+
+void LevelGenStats::add(const string& maker, bool success, int millis) {
+  auto& elem = makers[maker];
+  ++elem.numRuns;
+  if (!success)
+    ++elem.numFailures;
+  elem.totalMillis += millis;
+  elem.maxMillis = max(elem.maxMillis, millis);
+}
+
+void LevelGenStats::print(ostream& out) const {
+  for (auto& elem : makers)
+    out << "  " << elem.first << ": " << elem.second.numFailures << " / " << elem.second.numRuns << " failed. MaxT: "
+        << elem.second.maxMillis << ". AvgT: " << double(elem.second.totalMillis) / elem.second.numRuns << std::endl;
+}
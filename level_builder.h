@@ -40,6 +40,19 @@ RICH_ENUM(SquareAttrib,
   SOKOBAN_PRIZE
 );
 
+/** Per-maker success and timing counters, collected during the world generation test.*/
+struct LevelGenStats {
+  struct MakerStats {
+    int numRuns = 0;
+    int numFailures = 0;
+    int totalMillis = 0;
+    int maxMillis = 0;
+  };
+  map<string, MakerStats> makers;
+  void add(const string& maker, bool success, int millis);
+  void print(ostream&) const;
+};
+
 class LevelBuilder {
   public:
   /** Constructs a builder with given size and name. */
@@ -50,7 +63,7 @@ class LevelBuilder {
   LevelBuilder(LevelBuilder&&);
   ~LevelBuilder();
 
-  /** Returns a given square.*/
+  /** Returns a given square. Changes made through the returned pointer are not reverted by restore().*/
   WSquare modSquare(Vec2);
 
   /** Checks if it's possible to put a creature on given square.*/
@@ -110,6 +123,7 @@ class LevelBuilder {
 
   /** Sets the cover of the square. The value will remain if square is changed.*/
   void setCovered(Vec2, bool state);
+  bool isCovered(Vec2);
 
   /** Sets building flag for the purpose of building level. Buildings are recomputed after world generation
    * using the roof support algorithm for the sake of game mechanics */
@@ -128,9 +142,30 @@ class LevelBuilder {
 
   RandomGen& getRandom();
   ContentFactory* getContentFactory() const;
+
+  /** Marks a state that the builder can be rolled back to if a maker fails. Every checkpoint must be
+      either restored or released, in reverse order of creation.*/
+  struct Checkpoint {
+    int journalSize;
+  };
+  Checkpoint checkpoint();
+
+  /** Reverts all changes, including changes to the added collectives, made since the checkpoint.*/
+  void restore(Checkpoint);
+  void release(Checkpoint);
+
+  void setStats(LevelGenStats*);
+  LevelGenStats* getStats() const;
   
   private:
   Vec2 transform(Vec2);
+  void journalFurniture(Vec2 pos, FurnitureLayer);
+  void journalCollective(CollectiveBuilder*);
+  template <typename Fun>
+  void journal(Fun undo);
+  vector<function<void()>> undoJournal;
+  int numCheckpoints = 0;
+  LevelGenStats* stats = nullptr;
   SquareArray squares;
   Table<bool> unavailable;
   Table<double> heightMap;
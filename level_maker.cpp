@@ -232,6 +232,7 @@ class SquareChange {
 
   static SquareChange addTerritory(CollectiveBuilder* collective) {
     return SquareChange([=](LevelBuilder* builder, Vec2 pos) {
+      builder->addCollective(collective);
       collective->addArea(builder->toGlobalCoordinates(vector<Vec2>({pos})));
     });
   }
@@ -491,8 +492,8 @@ class Inhabitants : public LevelMaker {
       checkGen(!positions.empty());
       auto pos = builder->getRandom().choose(positions);
       if (collective) {
-        collective->addCreature(creature.get(), minion.second);
         builder->addCollective(collective);
+        collective->addCreature(creature.get(), minion.second);
       }
       builder->putCreature(pos, std::move(creature));
       taken[pos] = 1;
@@ -1152,6 +1153,10 @@ class RandomLocations : public LevelMaker {
     overlapping.insert(m);
   }
 
+  void setName(LevelMaker* m, const string& name) {
+    names[m] = name;
+  }
+
   LevelMaker* getLast() {
     return insideMakers.back().get();
   }
@@ -1184,13 +1189,42 @@ class RandomLocations : public LevelMaker {
     }
     {
       PROFILE_BLOCK("generating positions");
+      int numMakerFailures = 0;
       for (int i : Range(300))
-        if (tryMake(builder, allowedPositions, rotations))
+        if (tryMake(builder, allowedPositions, rotations, numMakerFailures))
           return;
       failGen(); // "Failed to find free space for " << (int)sizes.size() << " areas";
     }
   }
 
+  string getName(LevelMaker* maker) const {
+    if (auto name = getValueMaybe(names, maker))
+      return *name;
+    return typeid(*maker).name();
+  }
+
+  bool makeInside(LevelBuilder* builder, LevelMaker* maker, Rectangle area, LevelBuilder::Rot rotation) {
+#ifndef OSX
+    auto time = steady_clock::now();
+#endif
+    bool success = true;
+    builder->pushMap(area, rotation);
+    try {
+      maker->make(builder, area);
+    } catch (LevelGenException) {
+      success = false;
+    }
+    builder->popMap();
+    if (auto stats = builder->getStats()) {
+      int millis = 0;
+#ifndef OSX
+      millis = duration_cast<milliseconds>(steady_clock::now() - time).count();
+#endif
+      stats->add(getName(maker), success, millis);
+    }
+    return success;
+  }
+
   bool checkDistances(int makerIndex, Rectangle area, const vector<Rectangle>& occupied,
       const vector<optional<double>>& minDist, const vector<optional<double>>& maxDist) {
     for (int j : Range(makerIndex)) {
@@ -1209,7 +1243,7 @@ class RandomLocations : public LevelMaker {
   }
 
   bool tryMake(LevelBuilder* builder, const vector<vector<Vec2>>& allowedPositions,
-      const vector<LevelBuilder::Rot>& rotations) {
+      const vector<LevelBuilder::Rot>& rotations, int& numMakerFailures) {
     PROFILE;
     vector<Rectangle> occupied;
     vector<Rectangle> makerBounds;
@@ -1245,12 +1279,18 @@ class RandomLocations : public LevelMaker {
         return false;
     }
     CHECK(insideMakers.size() == occupied.size());
+    // If one of the makers fails then roll back and retry with new positions instead of regenerating the whole model.
+    auto checkpoint = builder->checkpoint();
     for (int i : All(insideMakers)) {
       PROFILE_BLOCK("insider makers");
-      builder->pushMap(makerBounds[i], rotations[i]);
-      insideMakers[i]->make(builder, makerBounds[i]);
-      builder->popMap();
+      if (!makeInside(builder, insideMakers[i].get(), makerBounds[i], rotations[i])) {
+        builder->restore(checkpoint);
+        if (++numMakerFailures >= maxMakerFailures)
+          failGen();
+        return false;
+      }
     }
+    builder->release(checkpoint);
     return true;
   }
 
@@ -1273,9 +1313,12 @@ class RandomLocations : public LevelMaker {
     }
     for (auto& elem : minMargin)
       check(elem.first);
+    for (auto& elem : names)
+      check(elem.first);
   }
 
   private:
+  const int maxMakerFailures = 10;
   vector<PLevelMaker> insideMakers;
   vector<pair<int, int>> sizes;
   vector<LocationPredicate> predicate;
@@ -1283,6 +1326,7 @@ class RandomLocations : public LevelMaker {
   map<pair<LevelMaker*, LevelMaker*>, double> minDistance;
   map<pair<LevelMaker*, LevelMaker*>, double> maxDistance;
   map<LevelMaker*, int> minMargin;
+  map<LevelMaker*, string> names;
 };
 
 class Margin : public LevelMaker {
@@ -1565,7 +1609,7 @@ class StartingPos : public LevelMaker {
   virtual void make(LevelBuilder* builder, Rectangle area) override {
     for (Vec2 pos : area)
       if (predicate.apply(builder, pos))
-        builder->modSquare(pos)->setLandingLink(stairKey);
+        builder->setLandingLink(pos, stairKey);
   }
 
   private:
@@ -1584,7 +1628,7 @@ class TransferPos : public LevelMaker {
       if (((pos.x - area.left() < width) || (pos.y - area.top() < width) ||
           (area.right() - pos.x <= width) || (area.bottom() - pos.y <= width)) &&
           predicate.apply(builder, pos)) {
-        builder->modSquare(pos)->setLandingLink(stairKey);
+        builder->setLandingLink(pos, stairKey);
         found = true;
       }
     checkGen(found);
@@ -1628,11 +1672,11 @@ class PlaceCollective : public LevelMaker {
       : collective(NOTNULL(c)), predicate(pred) {}
 
   virtual void make(LevelBuilder* builder, Rectangle area) override {
+    builder->addCollective(collective);
     if (!collective->hasCentralPoint())
       collective->setCentralPoint(builder->toGlobalCoordinates(area).middle());
     collective->addArea(builder->toGlobalCoordinates(area.getAllSquares()
         .filter([&](Vec2 pos) { return predicate.apply(builder, pos); })));
-    builder->addCollective(collective);
   }
 
   private:
@@ -1860,6 +1904,7 @@ class CastleExit : public LevelMaker {
   virtual void make(LevelBuilder* builder, Rectangle area) override {
     auto& building = settlement.buildingInfo;
     Vec2 loc(area.right() - 1, area.middle().y - 1);
+    builder->addCollective(settlement.collective);
     for (int i = 0; i < 2; ++i) {
       if (building.floorInside)
         builder->resetFurniture(loc + Vec2(2, i), *building.floorInside);
@@ -2605,15 +2650,17 @@ PLevelMaker LevelMaker::topLevel(RandomGen& random, optional<CreatureGroup> forr
   vector<SurroundWithResourcesInfo> surroundWithResources;
   for (SettlementInfo settlement : settlements) {
     auto queue = getSettlementMaker(random, settlement);
+    auto name = EnumInfo<SettlementType>::getString(settlement.type);
     if (settlement.cropsDistance)
       cottages.push_back({queue.get(), settlement.collective, settlement.tribe, *settlement.cropsDistance});
     if (settlement.corpses)
       queue->addMaker(unique<Corpses>(*settlement.corpses));
     if (settlement.surroundWithResources > 0)
       surroundWithResources.push_back({queue.get(), settlement});
-    if (settlement.type == SettlementType::SPIDER_CAVE)
+    if (settlement.type == SettlementType::SPIDER_CAVE) {
       locations2->add(std::move(queue), getSize(random, settlement.type), getSettlementPredicate(settlement));
-    else {
+      locations2->setName(locations2->getLast(), name);
+    } else {
       if (keeperTribe && !settlement.anyPlayerDistance) {
         if (settlement.closeToPlayer) {
           locations->setMinDistance(startingPos, queue.get(), 40);
@@ -2622,6 +2669,7 @@ PLevelMaker LevelMaker::topLevel(RandomGen& random, optional<CreatureGroup> forr
           locations->setMinDistance(startingPos, queue.get(), 70);
       }
       locations->add(std::move(queue), getSize(random, settlement.type), getSettlementPredicate(settlement));
+      locations->setName(locations->getLast(), name);
     }
   }
   Predicate lowlandPred = Predicate::attrib(SquareAttrib::LOWLAND) && !Predicate::attrib(SquareAttrib::RIVER);
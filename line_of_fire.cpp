@@ -0,0 +1,39 @@
+#include "stdafx.h"
+#include "line_of_fire.h"
+#include "draw_line.h"
+#include "position.h"
+
+LineOfFire::LineOfFire(WLevel l) : level(l) {
+}
+
+const LineOfFire::Line& LineOfFire::getLine(Vec2 from, Vec2 to, VisionId vision) {
+  auto key = make_tuple(from, to, vision);
+  if (auto line = getReferenceMaybe(lines, key))
+    return *line;
+  // The number of pairs asked about is unbounded, so start over once there are too many.
+  if (lines.size() >= 50000)
+    lines.clear();
+  Line line {false, drawLine(from, to)};
+  for (int i : Range(1, line.squares.size()))
+    if (Position(line.squares[i], level).stopsProjectiles(vision)) {
+      line.blocked = true;
+      line.squares.clear();
+      break;
+    }
+  return lines[key] = std::move(line);
+}
+
+bool LineOfFire::isObstructed(Vec2 from, Vec2 to, VisionId vision) {
+  PROFILE;
+  auto& line = getLine(from, to, vision);
+  if (line.blocked)
+    return true;
+  for (int i = 1; i < int(line.squares.size()) - 1; ++i)
+    if (Position(line.squares[i], level).getCreature())
+      return true;
+  return false;
+}
+
+void LineOfFire::squareChanged(Vec2) {
+  lines.clear();
+}
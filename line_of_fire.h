@@ -0,0 +1,27 @@
+#pragma once
+
+#include "util.h"
+
+/** Answers whether projectiles can fly between two squares of a level. Whether furniture is in the way is
+    cached for every pair of squares asked about, until any furniture on the level that could stop
+    projectiles changes. Creatures move all the time, so they are checked on every query, along the line
+    stored with the cached result.*/
+class LineOfFire {
+  public:
+  LineOfFire(WLevel);
+
+  /** Returns true if a projectile from 'from' can't reach 'to'. The square at 'to' may hold the target, but
+      it must not be blocked by furniture.*/
+  bool isObstructed(Vec2 from, Vec2 to, VisionId);
+  void squareChanged(Vec2);
+
+  private:
+  struct Line {
+    bool blocked;
+    vector<Vec2> squares;
+  };
+  const Line& getLine(Vec2 from, Vec2 to, VisionId);
+  WLevel level;
+  using Key = tuple<Vec2, Vec2, VisionId>;
+  unordered_map<Key, Line, CustomHash<Key>> lines;
+};
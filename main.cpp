@@ -40,6 +40,9 @@
 #include "version.h"
 #include "vision.h"
 #include "model_builder.h"
+#include "model.h"
+#include "collective.h"
+#include "memo.h"
 #include "sound_library.h"
 #include "audio_device.h"
 #include "sokoban_input.h"
@@ -52,6 +55,7 @@
 #include "name_generator.h"
 #include "enemy_factory.h"
 #include "tileset.h"
+#include "async_log.h"
 
 #include "fx_manager.h"
 #include "fx_renderer.h"
@@ -207,6 +211,7 @@ static po::parser getCommandLineFlags() {
   flags["data_dir"].type(po::string).description("Directory containing the game data");
   flags["restore_settings"].description("Restore settings to default values.");
   flags["run_tests"].description("Run all unit tests and exit");
+  flags["benchmark_matching"].description("Print the update latency of PositionMatching on a large layout and exit");
   flags["worldgen_test"].type(po::i32).description("Test how often world generation fails");
   flags["worldgen_maps"].type(po::string).description("List of maps or enemy types in world generation test. Skip to test all.");
   flags["battle_level"].type(po::string).description("Path to battle test level");
@@ -216,8 +221,16 @@ static po::parser getCommandLineFlags() {
   flags["verify_mod"].type(po::string).description("Verify mod. Requires path to zip file.");
   flags["battle_view"].description("Open game window and display battle");
   flags["battle_rounds"].type(po::i32).description("Number of battle rounds");
+  flags["battle_workers"].type(po::i32).description("Number of battles run in parallel. Defaults to the number of cores");
+  flags["turn_threads"].type(po::i32).description("Number of threads computing creatures' field of view before each turn");
+  flags["memo_stats"].description("Print hit rates of memoized queries on exit");
+  flags["check_cached_counts"].description("Verify cached resource and item counts of collectives against a full scan");
+  flags["profile"].description("Record PROFILE scopes with the built-in profiler");
+  flags["profile_trace"].type(po::string).description("Write recorded PROFILE scopes to a Chrome trace file on exit. Implies --profile");
+  flags["profile_overlay"].description("Show the slowest PROFILE scopes of the last frame and turn on screen. Implies --profile");
   flags["stderr"].description("Log to stderr");
   flags["nolog"].description("No logging");
+  flags["decode_log"].type(po::string).description("Print a binary log file as text");
   flags["free_mode"].description("Run in free ascii mode");
 #ifndef RELEASE
   flags["quick_game"].description("Skip main menu and load the last save file or start a single map game");
@@ -226,6 +239,8 @@ static po::parser getCommandLineFlags() {
   flags["seed"].type(po::i32).description("Use given seed");
   flags["record"].type(po::string).description("Record game to file");
   flags["replay"].type(po::string).description("Replay game from file");
+  flags["memory_report"].type(po::string).description("Print the memory used by each subsystem of a saved game");
+  flags["memory_sample"].type(po::i32).description("Print the memory used by headless battles every given number of turns");
   return flags;
 }
 
@@ -297,6 +312,10 @@ static int keeperMain(po::parser& commandLineFlags) {
     std::cout << commandLineFlags << endl;
     return 0;
   }
+  if (commandLineFlags["decode_log"].was_set()) {
+    AsyncLog::decode(commandLineFlags["decode_log"].get().string, std::cout);
+    return 0;
+  }
   bool useSingleThread =
 #ifndef RELEASE
       false;
@@ -309,9 +328,13 @@ static int keeperMain(po::parser& commandLineFlags) {
   UserErrorLog.addOutput(DebugOutput::toStream(std::cerr));
   UserInfoLog.addOutput(DebugOutput::toStream(std::cerr));
 #ifndef RELEASE
-  ogzstream compressedLog("log.gz");
-  if (!commandLineFlags["nolog"].was_set())
-    InfoLog.addOutput(DebugOutput::toStream(compressedLog));
+  optional<AsyncLog> binaryLog;
+  if (!commandLineFlags["nolog"].was_set()) {
+    binaryLog.emplace("log.bin.gz");
+    InfoLog.addOutput(binaryLog->getOutput());
+    // Make sure the last lines before a crash make it to the file.
+    FatalLog.addOutput(DebugOutput::toString([&binaryLog](const string&) { binaryLog->flush(); }));
+  }
 #endif
   FatalLog.addOutput(DebugOutput::toString(
       [](const string& s) { ofstream("stacktrace.out") << s << "\n" << std::flush; } ));
@@ -322,6 +345,10 @@ static int keeperMain(po::parser& commandLineFlags) {
     testAll();
     return 0;
   }
+  if (commandLineFlags["benchmark_matching"].was_set()) {
+    benchmarkPositionMatching();
+    return 0;
+  }
   DirectoryPath dataPath([&]() -> string {
     if (commandLineFlags["data_dir"].was_set())
       return commandLineFlags["data_dir"].get().string;
@@ -355,6 +382,21 @@ static int keeperMain(po::parser& commandLineFlags) {
   optional<int> maxTurns;
   if (commandLineFlags["max_turns"].was_set())
     maxTurns = commandLineFlags["max_turns"].get().i32;
+  if (commandLineFlags["turn_threads"].was_set())
+    Model::setNumTurnThreads(commandLineFlags["turn_threads"].get().i32);
+  Collective::setCheckCachedCounts(commandLineFlags["check_cached_counts"].was_set());
+  OnExit printMemoStats([&] {
+    if (commandLineFlags["memo_stats"].was_set())
+      MemoStats::printAll(std::cout);
+  });
+  if (commandLineFlags["profile"].was_set() || commandLineFlags["profile_trace"].was_set() ||
+      commandLineFlags["profile_overlay"].was_set())
+    Profiler::setEnabled(true);
+  Profiler::setOverlayEnabled(commandLineFlags["profile_overlay"].was_set());
+  OnExit writeProfileTrace([&] {
+    if (commandLineFlags["profile_trace"].was_set())
+      Profiler::writeChromeTrace(commandLineFlags["profile_trace"].get().string);
+  });
   Clock clock(!!maxTurns);
   userPath.createIfDoesntExist();
   auto settingsPath = userPath.file("options.txt");
@@ -409,19 +451,25 @@ static int keeperMain(po::parser& commandLineFlags) {
   auto battleTest = [&] (View* view, TileSet* tileSet) {
     MainLoop loop(view, &highscores, &fileSharing, freeDataPath, userPath, &options, &jukebox, &sokobanInput, tileSet,
         useSingleThread, 0, "");
+    if (commandLineFlags["memory_sample"].was_set())
+      loop.setMemorySampleTurns(commandLineFlags["memory_sample"].get().i32);
     auto level = commandLineFlags["battle_level"].get().string;
     auto info = commandLineFlags["battle_info"].get().string;
     auto numRounds = commandLineFlags["battle_rounds"].get().i32;
+    int numWorkers = commandLineFlags["battle_workers"].was_set()
+        ? commandLineFlags["battle_workers"].get().i32
+        : max<int>(1, thread::hardware_concurrency());
     try {
       if (commandLineFlags["endless_enemy"].was_set()) {
         auto enemy = commandLineFlags["endless_enemy"].get().string;
         optional<int> chosenEnemy;
         if (enemy != "all")
           chosenEnemy = fromString<int>(enemy);
-        loop.endlessTest(numRounds, FilePath::fromFullPath(level), FilePath::fromFullPath(info), Random, chosenEnemy);
+        loop.endlessTest(numRounds, FilePath::fromFullPath(level), FilePath::fromFullPath(info), Random, chosenEnemy,
+            numWorkers);
       } else {
         auto enemyId = commandLineFlags["battle_enemy"].get().string;
-        loop.battleTest(numRounds, FilePath::fromFullPath(level), FilePath::fromFullPath(info), enemyId, Random);
+        loop.battleTest(numRounds, FilePath::fromFullPath(level), FilePath::fromFullPath(info), enemyId, Random, numWorkers);
       }
     } catch (GameExitException) {}
   };
@@ -429,6 +477,21 @@ static int keeperMain(po::parser& commandLineFlags) {
     battleTest(new DummyView(&clock), nullptr);
     return 0;
   }
+  if (commandLineFlags["replay"].was_set()) {
+    DummyView view(&clock);
+    MainLoop loop(&view, &highscores, &fileSharing, freeDataPath, userPath, &options, &jukebox, &sokobanInput, nullptr,
+        true, saveVersion, modVersion);
+    if (auto error = loop.replay(FilePath::fromFullPath(commandLineFlags["replay"].get().string)))
+      USER_FATAL << *error;
+    return 0;
+  }
+  if (commandLineFlags["memory_report"].was_set()) {
+    DummyView view(&clock);
+    MainLoop loop(&view, &highscores, &fileSharing, freeDataPath, userPath, &options, &jukebox, &sokobanInput, nullptr,
+        true, saveVersion, modVersion);
+    loop.reportMemory(FilePath::fromFullPath(commandLineFlags["memory_report"].get().string));
+    return 0;
+  }
   Renderer renderer(
       &clock,
       "KeeperRL",
@@ -470,7 +533,8 @@ static int keeperMain(po::parser& commandLineFlags) {
   }
   if (tilesPresent)
     initializeRendererTiles(renderer, paidDataPath.subdirectory("images"));
-  TileSet tileSet(paidDataPath.subdirectory("images"), freeDataPath.subdirectory(gameConfigSubdir));
+  TileSet tileSet(paidDataPath.subdirectory("images"), freeDataPath.subdirectory(gameConfigSubdir),
+      userPath.subdirectory("tile_cache"));
   renderer.setTileSet(&tileSet);
   FileSharing bugreportSharing("http://retired.keeperrl.com/~bugreports", modVersion, saveVersion, options, installId);
   unique_ptr<View> view;
@@ -499,6 +563,8 @@ static int keeperMain(po::parser& commandLineFlags) {
   }
   MainLoop loop(view.get(), &highscores, &fileSharing, freeDataPath, userPath, &options, &jukebox, &sokobanInput, &tileSet,
       useSingleThread, saveVersion, modVersion);
+  if (commandLineFlags["record"].was_set())
+    loop.setRecordPath(FilePath::fromFullPath(commandLineFlags["record"].get().string));
   try {
     if (audioError)
       view->presentText("Failed to initialize audio. The game will be started without sound.", *audioError);
@@ -39,18 +39,27 @@
 #include "tileset.h"
 #include "content_factory.h"
 #include "scroll_position.h"
-#include "miniunz.h"
+#include "zip_archive.h"
 #include "external_enemies_type.h"
 #include "mod_info.h"
 #include "container_range.h"
 #include "extern/iomanip.h"
 #include "enemy_info.h"
+#include "input_queue.h"
+#include "memory_report.h"
+#include "object_pool.h"
+#include "async_log.h"
 
 #ifdef USE_STEAMWORKS
 #include "steam_ugc.h"
 #include "steam_client.h"
 #endif
 
+#ifndef WINDOWS
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
 MainLoop::MainLoop(View* v, Highscores* h, FileSharing* fSharing, const DirectoryPath& freePath,
     const DirectoryPath& uPath, Options* o, Jukebox* j, SokobanInput* soko, TileSet* tileSet, bool singleThread, int sv, string modVersion)
       : view(v), dataFreePath(freePath), userPath(uPath), options(o), jukebox(j), highscores(h), fileSharing(fSharing),
@@ -123,12 +132,14 @@ static string stripFilename(string s) {
 }
 
 void MainLoop::saveGame(PGame& game, const FilePath& path) {
-  CompressedOutput out(path.getPath());
-  string name = game->getGameDisplayName();
-  SavedGameInfo savedInfo = game->getSavedGameInfo();
-  savedInfo.spriteMods = tileSet->getSpriteMods();
-  out.getArchive() << saveVersion << name << savedInfo;
-  out.getArchive() << game;
+  SaveFileHeader header {saveVersion, game->getGameDisplayName(), game->getSavedGameInfo(), 0};
+  header.info.spriteMods = tileSet->getSpriteMods();
+  {
+    CompressedOutput out(path.getPath());
+    out.getArchive() << header.version << header.name << header.info;
+    out.getArchive() << game;
+  }
+  writeSaveFileHeader(path, std::move(header));
 }
 
 struct RetiredModelInfo {
@@ -138,21 +149,23 @@ struct RetiredModelInfo {
 };
 
 void MainLoop::saveMainModel(PGame& game, const FilePath& path) {
-  CompressedOutput out(path.getPath());
-  string name = game->getGameDisplayName();
-  SavedGameInfo savedInfo = game->getSavedGameInfo();
-  savedInfo.spriteMods = tileSet->getSpriteMods();
-  out.getArchive() << saveVersion << name << savedInfo;
-  RetiredModelInfo info {
-    std::move(game->getMainModel()),
-    game->removeContentFactory()
-  };
-  out.getArchive() << info;
+  SaveFileHeader header {saveVersion, game->getGameDisplayName(), game->getSavedGameInfo(), 0};
+  header.info.spriteMods = tileSet->getSpriteMods();
+  {
+    CompressedOutput out(path.getPath());
+    out.getArchive() << header.version << header.name << header.info;
+    RetiredModelInfo info {
+      std::move(game->getMainModel()),
+      game->removeContentFactory()
+    };
+    out.getArchive() << info;
+  }
+  writeSaveFileHeader(path, std::move(header));
 }
 
 int MainLoop::getSaveVersion(const SaveFileInfo& save) {
-  if (auto info = getNameAndVersion(userPath.file(save.filename)))
-    return info->second;
+  if (auto header = loadSaveFileHeader(userPath.file(save.filename)))
+    return header->version;
   else
     return -1;
 }
@@ -206,7 +219,7 @@ void MainLoop::saveUI(PGame& game, GameSaveType type, SplashType splashType) {
 }
 
 void MainLoop::eraseSaveFile(const PGame& game, GameSaveType type) {
-  remove(getSavePath(game, type).getPath());
+  removeSaveFile(getSavePath(game, type));
 }
 
 void MainLoop::getSaveOptions(const vector<pair<GameSaveType, string>>& games, vector<ListElem>& options,
@@ -219,8 +232,8 @@ void MainLoop::getSaveOptions(const vector<pair<GameSaveType, string>>& games, v
       options.emplace_back(elem.second, ListElem::TITLE);
       append(options, files.transform(
           [this] (const SaveFileInfo& info) {
-              auto nameAndVersion = getNameAndVersion(userPath.file(info.filename));
-              return ListElem(nameAndVersion->first, getDateString(info.date));}));
+              auto header = loadSaveFileHeader(userPath.file(info.filename));
+              return ListElem(header->name, getDateString(info.date));}));
     }
   }
 }
@@ -258,6 +271,10 @@ void MainLoop::bugReportSave(PGame& game, FilePath path) {
   Square::progressMeter = nullptr;
 }
 
+static FilePath getRecordedGamePath(const FilePath& recordPath) {
+  return FilePath::fromFullPath(recordPath.getPath() + ".kep"_s);
+}
+
 MainLoop::ExitCondition MainLoop::playGame(PGame game, bool withMusic, bool noAutoSave, bool splashScreen,
     function<optional<ExitCondition>(WGame)> exitCondition, milliseconds stepTimeMilli, optional<int> maxTurns) {
   if (!splashScreen)
@@ -267,6 +284,26 @@ MainLoop::ExitCondition MainLoop::playGame(PGame game, bool withMusic, bool noAu
       registerModPlaytime(false);
   });
 
+  optional<InputQueue> recording;
+  if (recordPath && !splashScreen) {
+    // The replay starts from a saved copy of the game, so continue with the loaded copy as well
+    // to make sure that both start from exactly the same state.
+    auto gamePath = getRecordedGamePath(*recordPath);
+    saveGame(game, gamePath);
+    game = loadGame(gamePath);
+    CHECK(!!game) << "Failed to reload " << gamePath;
+    int seed = Random.get(1000000000);
+    Random.init(seed);
+    recording = InputQueue::record(seed);
+    game->setInputQueue(&*recording);
+  }
+  OnExit saveRecording([&] {
+    if (recording) {
+      INFO << "Saving " << recording->getNumUpdates() << " recorded updates to " << *recordPath;
+      CompressedOutput out(recordPath->getPath());
+      out.getArchive() << saveVersion << *recording;
+    }
+  });
   tileSet->setTilePaths(game->getContentFactory()->tilePaths);
   view->reset();
   if (!noAutoSave)
@@ -340,6 +377,68 @@ MainLoop::ExitCondition MainLoop::playGame(PGame game, bool withMusic, bool noAu
   }
 }
 
+void MainLoop::setRecordPath(const FilePath& path) {
+  recordPath = path;
+}
+
+optional<string> MainLoop::replay(const FilePath& path) {
+  InputQueue recorded;
+  try {
+    CompressedInput in(path.getPath());
+    int version;
+    in.getArchive() >> version;
+    if (!isCompatible(version))
+      return "Recording "_s + path.getPath() + " has incompatible version " + toString(version);
+    in.getArchive() >> recorded;
+  } catch (std::exception&) {
+    return "Failed to read recording "_s + path.getPath();
+  }
+  auto gamePath = getRecordedGamePath(path);
+  auto game = loadGame(gamePath);
+  if (!game)
+    return "Failed to load "_s + gamePath.getPath();
+  auto queue = InputQueue::replay(std::move(recorded));
+  Random.init(queue.getSeed());
+  game->setInputQueue(&queue);
+  game->initialize(options, highscores, view, fileSharing);
+#ifndef OSX
+  auto time = steady_clock::now();
+#endif
+  int numUpdates = 0;
+  while (!queue.isFinished() && !queue.getMismatch()) {
+    ++numUpdates;
+    if (game->update(1))
+      break;
+  }
+  std::cout << "Replayed " << numUpdates << " of " << queue.getNumUpdates() << " updates, reached turn "
+      << game->getGlobalTime().getVisibleInt() << std::endl;
+#ifndef OSX
+  std::cout << "Took " << duration_cast<milliseconds>(steady_clock::now() - time).count() << "ms" << std::endl;
+#endif
+  if (auto update = queue.getMismatch())
+    std::cout << "Game state differs from the recording at update " << *update << std::endl;
+  else
+    std::cout << "All checkpoints match the recording" << std::endl;
+  return none;
+}
+
+void MainLoop::reportMemory(const FilePath& path) {
+  auto game = loadGame(path);
+  CHECK(!!game) << "Failed to load " << path;
+  game->initialize(options, highscores, view, fileSharing);
+  MemoryReport report("game");
+  game->reportMemory(report);
+  report.print(std::cout);
+  // Pooled objects are already estimated in the game's report, so the pools are listed separately.
+  MemoryReport pools("object pools");
+  ObjectPool::reportMemory(pools);
+  pools.print(std::cout);
+}
+
+void MainLoop::setMemorySampleTurns(int turns) {
+  memorySampleTurns = turns;
+}
+
 void MainLoop::eraseAllSavesExcept(const PGame& game, optional<GameSaveType> except) {
   for (auto erasedType : ENUM_ALL(GameSaveType))
     if (erasedType != except)
@@ -351,13 +450,13 @@ optional<RetiredGames> MainLoop::getRetiredGames(CampaignType type) {
     case CampaignType::FREE_PLAY: {
       RetiredGames ret;
       for (auto& info : getSaveFiles(userPath, getSaveSuffix(GameSaveType::RETIRED_CAMPAIGN)))
-        if (isCompatible(getSaveVersion(info)))
-          if (auto saved = loadSavedGameInfo(userPath.file(info.filename)))
-            ret.addLocal(*saved, info, true);
+        if (auto header = loadSaveFileHeader(userPath.file(info.filename)))
+          if (isCompatible(header->version))
+            ret.addLocal(header->info, info, true);
       for (auto& info : getSaveFiles(userPath, getSaveSuffix(GameSaveType::RETIRED_SITE)))
-        if (isCompatible(getSaveVersion(info)))
-          if (auto saved = loadSavedGameInfo(userPath.file(info.filename)))
-            ret.addLocal(*saved, info, false);
+        if (auto header = loadSaveFileHeader(userPath.file(info.filename)))
+          if (isCompatible(header->version))
+            ret.addLocal(header->info, info, false);
       optional<vector<FileSharing::SiteInfo>> onlineSites;
       doWithSplash(SplashType::SMALL, "Fetching list of retired dungeons from the server...",
           [&] { onlineSites = fileSharing->listSites(); }, [&] { fileSharing->cancel(); });
@@ -858,7 +957,7 @@ static CreatureList readAlly(ifstream& input) {
 }
 
 void MainLoop::battleTest(int numTries, const FilePath& levelPath, const FilePath& battleInfoPath, string enemy,
-    RandomGen& random) {
+    RandomGen& random, int numWorkers) {
   ifstream input(battleInfoPath.getPath());
   CreatureList enemies;
   for (auto& elem : split(enemy, {','})) {
@@ -874,12 +973,12 @@ void MainLoop::battleTest(int numTries, const FilePath& levelPath, const FilePat
   for (int i : Range(cnt)) {
     auto allies = readAlly(input);
     std::cout << allies.getSummary(&contentFactory.getCreatures()) << ": ";
-    battleTest(numTries, levelPath, allies, enemies, random);
+    battleTest(numTries, levelPath, allies, enemies, &contentFactory, random, numWorkers);
   }
 }
 
 void MainLoop::endlessTest(int numTries, const FilePath& levelPath, const FilePath& battleInfoPath,
-    RandomGen& random, optional<int> numEnemy) {
+    RandomGen& random, optional<int> numEnemy, int numWorkers) {
   ifstream input(battleInfoPath.getPath());
   int cnt = 0;
   input >> cnt;
@@ -896,7 +995,8 @@ void MainLoop::endlessTest(int numTries, const FilePath& levelPath, const FilePa
       int totalWins = 0;
       for (auto& allyInfo : allies) {
         std::cerr << allyInfo.getSummary(&contentFactory.getCreatures()) << ": ";
-        int numWins = battleTest(numTries, levelPath, allyInfo, wave->enemy.creatures, random);
+        int numWins = battleTest(numTries, levelPath, allyInfo, wave->enemy.creatures, &contentFactory, random,
+            numWorkers);
         totalWins += numWins;
       }
       std::cerr << totalWins << " wins\n";
@@ -905,11 +1005,10 @@ void MainLoop::endlessTest(int numTries, const FilePath& levelPath, const FilePa
 }
 
 optional<string> MainLoop::verifyMod(const string& path) {
-  auto modsPath = userPath.subdirectory("mods_tmp");
-  OnExit ex123([modsPath] { modsPath.removeRecursively(); });
-  modsPath.createIfDoesntExist();
-  if (auto err = unzip(path, modsPath.getPath()))
-    return err;
+  auto archive = ZipArchive::open(path);
+  if (!archive)
+    return "Cannot open " + path;
+  auto modsPath = DirectoryPath::inArchive(archive);
   for (auto mod : modsPath.getSubDirs()) {
     GameConfig config(modsPath, mod);
     ContentFactory f;
@@ -923,65 +1022,146 @@ optional<string> MainLoop::verifyMod(const string& path) {
   return "Failed to load any mod"_s;
 }
 
-int MainLoop::battleTest(int numTries, const FilePath& levelPath, CreatureList ally, CreatureList enemies,
-    RandomGen& random) {
+MainLoop::ExitCondition MainLoop::runBattle(ContentFactory contentFactory, const FilePath& levelPath,
+    CreatureList ally, CreatureList enemies) {
   ProgressMeter meter(1);
-  int numAllies = 0;
-  int numEnemies = 0;
-  int numUnknown = 0;
   auto allyTribe = TribeId::getDarkKeeper();
-  std::cout.flush();
-  for (int i : Range(numTries)) {
-    std::cout << "Creating level" << std::endl;
-    auto contentFactory = createContentFactory(false);
-    EnemyFactory enemyFactory(Random, contentFactory.getCreatures().getNameGenerator(),
-        contentFactory.enemies, contentFactory.buildingInfo, contentFactory.externalEnemies);
-    auto model = ModelBuilder(&meter, Random, options, sokobanInput,
-        &contentFactory, std::move(enemyFactory)).battleModel(levelPath, ally, enemies);
-    auto game = Game::splashScreen(std::move(model), CampaignBuilder::getEmptyCampaign(), std::move(contentFactory));
-    std::cout << "Done" << std::endl;
-    auto exitCondition = [&](WGame game) -> optional<ExitCondition> {
-      unordered_set<TribeId, CustomHash<TribeId>> tribes;
-      for (auto& m : game->getAllModels())
-        for (auto c : m->getAllCreatures())
-          tribes.insert(c->getTribeId());
-      if (tribes.size() == 1) {
-        if (*tribes.begin() == allyTribe)
-          return ExitCondition::ALLIES_WON;
-        else
-          return ExitCondition::ENEMIES_WON;
-      }
-      if (game->getGlobalTime().getVisibleInt() > 200)
-        return ExitCondition::TIMEOUT;
-      if (tribes.empty())
-        return ExitCondition::UNKNOWN;
+  EnemyFactory enemyFactory(Random, contentFactory.getCreatures().getNameGenerator(),
+      contentFactory.enemies, contentFactory.buildingInfo, contentFactory.externalEnemies);
+  auto model = ModelBuilder(&meter, Random, options, sokobanInput,
+      &contentFactory, std::move(enemyFactory)).battleModel(levelPath, ally, enemies);
+  auto game = Game::splashScreen(std::move(model), CampaignBuilder::getEmptyCampaign(), std::move(contentFactory));
+  auto exitCondition = [&](WGame game) -> optional<ExitCondition> {
+    unordered_set<TribeId, CustomHash<TribeId>> tribes;
+    for (auto& m : game->getAllModels())
+      for (auto c : m->getAllCreatures())
+        tribes.insert(c->getTribeId());
+    if (tribes.size() == 1) {
+      if (*tribes.begin() == allyTribe)
+        return ExitCondition::ALLIES_WON;
       else
-        return none;
-    };
-    auto result = playGame(std::move(game), false, true, false, exitCondition, milliseconds{3});
-    switch (result) {
-      case ExitCondition::ALLIES_WON:
-        ++numAllies;
-        std::cerr << "a";
-        break;
-      case ExitCondition::ENEMIES_WON:
-        ++numEnemies;
-        std::cerr << "e";
-        break;
-      case ExitCondition::TIMEOUT:
-        ++numUnknown;
-        std::cerr << "t";
-        break;
-      case ExitCondition::UNKNOWN:
-        ++numUnknown;
-        std::cerr << "u";
-        break;
+        return ExitCondition::ENEMIES_WON;
+    }
+    if (game->getGlobalTime().getVisibleInt() > 200)
+      return ExitCondition::TIMEOUT;
+    if (tribes.empty())
+      return ExitCondition::UNKNOWN;
+    else
+      return none;
+  };
+  if (tileSet)
+    return playGame(std::move(game), false, true, false, exitCondition, milliseconds{3});
+  // Nobody is watching, so don't pace the simulation.
+  game->initialize(options, highscores, view, fileSharing);
+  int lastSample = -1;
+  while (1) {
+    if (game->update(1))
+      return ExitCondition::UNKNOWN;
+    if (auto c = exitCondition(game.get()))
+      return *c;
+    int turn = game->getGlobalTime().getVisibleInt();
+    if (memorySampleTurns && turn % *memorySampleTurns == 0 && turn != lastSample) {
+      lastSample = turn;
+      MemoryReport report("game");
+      game->reportMemory(report);
+      std::cout << "Turn " << turn << " memory: " << report.getLiveBytes() << " bytes live, "
+          << report.getReservedBytes() << " bytes reserved" << std::endl;
     }
+  }
+}
+
+#ifndef WINDOWS
+static const int workerResultOffset = 100;
+#endif
+
+// The simulation uses process-wide state, such as the Random generator, so instead of threads the workers
+// are forked processes. They inherit the already parsed content and report the result through the exit code.
+void MainLoop::runInWorkers(int numTries, int numWorkers, RandomGen& random, function<int(bool inWorker)> fun,
+    function<void(optional<int>)> onResult) {
+#ifndef WINDOWS
+  if (numWorkers > 1) {
+    std::cout.flush();
     std::cerr.flush();
+    int numRunning = 0;
+    auto waitForWorker = [&] {
+      int status = 0;
+      CHECK(wait(&status) > 0);
+      --numRunning;
+      if (WIFEXITED(status) && WEXITSTATUS(status) >= workerResultOffset)
+        onResult(WEXITSTATUS(status) - workerResultOffset);
+      else
+        onResult(none);
+    };
+    for (int i : Range(numTries)) {
+      if (numRunning >= numWorkers)
+        waitForWorker();
+      int seed = random.get(1000000000);
+      AsyncLog::prepareFork();
+      auto pid = fork();
+      AsyncLog::afterFork(pid == 0);
+      CHECK(pid >= 0) << "Failed to start battle worker";
+      if (pid == 0) {
+        Random.init(seed);
+        _exit(workerResultOffset + fun(true));
+      }
+      ++numRunning;
+    }
+    while (numRunning > 0)
+      waitForWorker();
+    return;
   }
+#endif
+  for (int i : Range(numTries))
+    onResult(fun(false));
+}
+
+int MainLoop::battleTest(int numTries, const FilePath& levelPath, CreatureList ally, CreatureList enemies,
+    ContentFactory* contentFactory, RandomGen& random, int numWorkers) {
+  int numAllies = 0;
+  int numEnemies = 0;
+  int numUnknown = 0;
+  std::cout.flush();
+  runInWorkers(numTries, tileSet ? 1 : numWorkers, random,
+      [&] (bool inWorker) {
+        // A worker owns its copy of the parsed content, otherwise every battle gets a copy of it.
+        return int(runBattle(inWorker ? std::move(*contentFactory) : ContentFactory(*contentFactory), levelPath,
+            ally, enemies));
+      },
+      [&] (optional<int> result) {
+        auto condition = result && *result <= int(ExitCondition::UNKNOWN) ? ExitCondition(*result) : ExitCondition::UNKNOWN;
+        switch (condition) {
+          case ExitCondition::ALLIES_WON:
+            ++numAllies;
+            std::cerr << "a";
+            break;
+          case ExitCondition::ENEMIES_WON:
+            ++numEnemies;
+            std::cerr << "e";
+            break;
+          case ExitCondition::TIMEOUT:
+            ++numUnknown;
+            std::cerr << "t";
+            break;
+          case ExitCondition::UNKNOWN:
+            ++numUnknown;
+            std::cerr << "u";
+            break;
+        }
+        std::cerr.flush();
+      });
   std::cerr << " " << numAllies << ":" << numEnemies;
   if (numUnknown > 0)
     std::cerr << " (" << numUnknown << ") unknown";
+  if (numTries > 0) {
+    // 95% Wilson score interval of the allies' win rate.
+    const double z = 1.96;
+    double n = numTries;
+    double p = numAllies / n;
+    double center = (p + z * z / (2 * n)) / (1 + z * z / n);
+    double radius = z * sqrt(p * (1 - p) / n + z * z / (4 * n * n)) / (1 + z * z / n);
+    std::cerr << " win rate " << int(100 * p) << "% [" << int(100 * max(0.0, center - radius)) << "%, "
+        << int(100 * min(1.0, center + radius)) << "%]";
+  }
   std::cerr << "\n";
   return numAllies;
 }
@@ -1005,11 +1185,13 @@ ModelTable MainLoop::prepareCampaignModels(CampaignSetup& setup, const AvatarInf
     ContentFactory* contentFactory) {
   Table<PModel> models(setup.campaign.getSites().getBounds());
   auto& sites = setup.campaign.getSites();
+  vector<SaveFileInfo> toDownload;
   for (Vec2 v : sites.getBounds())
-    if (auto retired = sites[v].getRetired()) {
-      if (retired->fileInfo.download)
-        downloadGame(retired->fileInfo);
-    }
+    if (auto retired = sites[v].getRetired())
+      if (retired->fileInfo.download && !isDownloaded(retired->fileInfo))
+        toDownload.push_back(retired->fileInfo);
+  if (!toDownload.empty())
+    downloadGames(toDownload);
   optional<string> failedToLoad;
   int numSites = setup.campaign.getNumNonEmpty();
   vector<ContentFactory> factories;
@@ -1043,8 +1225,8 @@ ModelTable MainLoop::prepareCampaignModels(CampaignSetup& setup, const AvatarInf
 
 PGame MainLoop::loadGame(const FilePath& file) {
   optional<PGame> game;
-  if (auto info = loadSavedGameInfo(file))
-    doWithSplash(SplashType::AUTOSAVING, "Loading "_s + file.getPath() + "...", info->progressCount,
+  if (auto header = loadSaveFileHeader(file))
+    doWithSplash(SplashType::AUTOSAVING, "Loading "_s + file.getPath() + "...", header->info.progressCount,
         [&] (ProgressMeter& meter) {
           Square::progressMeter = &meter;
           INFO << "Loading from " << file;
@@ -1054,20 +1236,34 @@ PGame MainLoop::loadGame(const FilePath& file) {
   return game ? std::move(*game) : nullptr;
 }
 
-bool MainLoop::downloadGame(const SaveFileInfo& file) {
+// Sites keep their file name when they are uploaded again, so a local copy is only reused if it's
+// at least as new as the upload.
+bool MainLoop::isDownloaded(const SaveFileInfo& file) {
+  auto path = userPath.file(file.filename);
+  return path.exists() && path.getModificationTime() >= file.date && !!loadSaveFileHeader(path);
+}
+
+void MainLoop::downloadGames(const vector<SaveFileInfo>& files) {
   atomic<bool> cancelled(false);
-  optional<string> error;
-  doWithSplash(SplashType::AUTOSAVING, "Downloading " + file.filename + "...", 1,
+  vector<optional<string>> errors;
+  doWithSplash(SplashType::AUTOSAVING, files.size() == 1 ? "Downloading " + files[0].filename + "..."
+          : "Downloading " + toString(files.size()) + " sites...", files.size(),
       [&] (ProgressMeter& meter) {
-        error = fileSharing->downloadSite(file, userPath, meter);
+        errors = fileSharing->downloadSites(files, userPath, meter);
       },
       [&] {
         cancelled = true;
         fileSharing->cancel();
       });
-  if (error && !cancelled)
-    view->presentText("Error downloading file", *error);
-  return !error;
+  string errorText;
+  for (int i : All(files))
+    if (errors[i])
+      errorText += files[i].filename + ": " + *errors[i] + "\n";
+    else
+      // Build the header file now, rather than the first time a menu lists the site.
+      loadSaveFileHeader(userPath.file(files[i].filename));
+  if (!errorText.empty() && !cancelled)
+    view->presentText("Error downloading file", errorText);
 }
 
 static void changeSaveType(const FilePath& file, GameSaveType newType) {
@@ -1082,8 +1278,7 @@ static void changeSaveType(const FilePath& file, GameSaveType newType) {
     }
   }
   CHECK(!!newFile);
-  remove(newFile->getPath());
-  rename(file.getPath(), newFile->getPath());
+  renameSaveFile(file, *newFile);
 }
 
 PGame MainLoop::loadPrevious() {
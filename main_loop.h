@@ -39,13 +39,29 @@ class MainLoop {
 
   void start(bool tilesPresent);
   void modelGenTest(int numTries, const vector<std::string>& types, RandomGen&, Options*);
-  void battleTest(int numTries, const FilePath& levelPath, const FilePath& battleInfoPath, string enemyId, RandomGen&);
-  int battleTest(int numTries, const FilePath& levelPath, CreatureList ally, CreatureList enemyId, RandomGen&);
-  void endlessTest(int numTries, const FilePath& levelPath, const FilePath& battleInfoPath, RandomGen&, optional<int> numEnemy);
+  void battleTest(int numTries, const FilePath& levelPath, const FilePath& battleInfoPath, string enemyId, RandomGen&,
+      int numWorkers);
+  int battleTest(int numTries, const FilePath& levelPath, CreatureList ally, CreatureList enemyId, ContentFactory*,
+      RandomGen&, int numWorkers);
+  void endlessTest(int numTries, const FilePath& levelPath, const FilePath& battleInfoPath, RandomGen&, optional<int> numEnemy,
+      int numWorkers);
   optional<string> verifyMod(const string& path);
   void launchQuickGame(optional<int> maxTurns);
+  /** Records the input of the next game played to the given file, so that it can be replayed later.*/
+  void setRecordPath(const FilePath&);
+  /** Plays back a recorded game without a view, as fast as possible, and checks it against the recording.
+      Returns an error if the recording or its game can't be loaded.*/
+  optional<string> replay(const FilePath&);
+  /** Loads a saved game and prints how much memory its subsystems take.*/
+  void reportMemory(const FilePath& savePath);
+  /** Makes headless battles print the total memory of the game every given number of turns.*/
+  void setMemorySampleTurns(int);
 
   static TimeInterval getAutosaveFreq();
+  /** Calls fun numTries times, in up to numWorkers forked processes if possible, passing each result, or
+      none if a worker crashed, to onResult in the calling process. Results must be in [0, 155].*/
+  static void runInWorkers(int numTries, int numWorkers, RandomGen&, function<int(bool inWorker)> fun,
+      function<void(optional<int>)> onResult);
 
   private:
 
@@ -68,6 +84,7 @@ class MainLoop {
   enum class ExitCondition;
   ExitCondition playGame(PGame, bool withMusic, bool noAutoSave, bool splashScreen,
       function<optional<ExitCondition> (WGame)> = nullptr, milliseconds stepTimeMilli = milliseconds{3}, optional<int> maxTurns = none);
+  ExitCondition runBattle(ContentFactory, const FilePath& levelPath, CreatureList ally, CreatureList enemies);
   void splashScreen();
   void showCredits(const FilePath& path);
   void showMods();
@@ -79,7 +96,8 @@ class MainLoop {
   FilePath getSavePath(const PGame&, GameSaveType);
   void eraseSaveFile(const PGame&, GameSaveType);
 
-  bool downloadGame(const SaveFileInfo&);
+  void downloadGames(const vector<SaveFileInfo>&);
+  bool isDownloaded(const SaveFileInfo&);
   bool eraseSave();
   static vector<SaveFileInfo> getSaveFiles(const DirectoryPath& path, const string& suffix);
   bool isCompatible(int loadedVersion);
@@ -98,6 +116,8 @@ class MainLoop {
   TileSet* tileSet;
   int saveVersion;
   string modVersion;
+  optional<FilePath> recordPath;
+  optional<int> memorySampleTurns;
   PModel getBaseModel(ModelBuilder&, CampaignSetup&, const AvatarInfo&);
   void considerGameEventsPrompt();
   void considerFreeVersionText(bool tilesPresent);
@@ -55,7 +55,9 @@ MapGui::~MapGui() = default;
 constexpr int fireVar = 50;
 
 static Color getFireColor() {
-  return Color(200 + Random.get(-fireVar, fireVar), Random.get(fireVar), Random.get(fireVar), 150);
+  // Don't use the game's generator for visual noise, or recorded games wouldn't replay the same without a view.
+  static RandomGen random;
+  return Color(200 + random.get(-fireVar, fireVar), random.get(fireVar), random.get(fireVar), 150);
 }
 
 void MapGui::setButtonViewId(ViewId id) {
@@ -1303,8 +1305,7 @@ void MapGui::updateObjects(CreatureView* view, Renderer& renderer, MapLayout* ma
   // team members in turn-based mode.
   bool newView = (view->getCenterType() != previousView);
   if (newView || level != previousLevel)
-    for (Vec2 pos : level->getBounds())
-      level->setNeedsRenderUpdate(pos, true);
+    level->setNeedsRenderUpdate(level->getBounds(), true);
   else
     for (Vec2 pos : mapLayout->getAllTiles(getBounds(), Level::getMaxBounds(), getScreenPos()))
       if (level->needsRenderUpdate(pos) ||
@@ -19,6 +19,7 @@
 #include "level.h"
 #include "view_object.h"
 #include "view_index.h"
+#include "memory_report.h"
 
 SERIALIZE_DEF(MapMemory, table)
 
@@ -64,6 +65,12 @@ const MapMemory& MapMemory::empty() {
   return mem;
 } 
 
+void MapMemory::reportMemory(MemoryReport& report) const {
+  table->reportMemory(report.get("view indexes"));
+  for (auto& elem : updated)
+    report.get("updated").addNodes(elem.second);
+}
+
 const unordered_set<Position, CustomHash<Position>>& MapMemory::getUpdated(WConstLevel level) const {
   return updated[level->getUniqueId()];
 }
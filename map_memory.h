@@ -22,6 +22,7 @@
 
 class ViewObject;
 class ViewIndex;
+class MemoryReport;
 
 class MapMemory {
   public:
@@ -33,6 +34,7 @@ class MapMemory {
   void clearSquare(Position pos);
   static const MapMemory& empty();
   optional<const ViewIndex&> getViewIndex(Position) const;
+  void reportMemory(MemoryReport&) const;
 
   template <class Archive> 
   void serialize(Archive& ar, const unsigned int version);
@@ -0,0 +1,34 @@
+#include "stdafx.h"
+#include "memo.h"
+
+static std::mutex& getRegistryMutex() {
+  static std::mutex ret;
+  return ret;
+}
+
+static vector<MemoStats*>& getRegistry() {
+  static vector<MemoStats*> ret;
+  return ret;
+}
+
+MemoStats::MemoStats(const char* name) : name(name), hits(0), misses(0) {
+  std::lock_guard<std::mutex> lock(getRegistryMutex());
+  getRegistry().push_back(this);
+}
+
+void MemoStats::printAll(std::ostream& out) {
+  std::lock_guard<std::mutex> lock(getRegistryMutex());
+  for (auto stats : getRegistry()) {
+    long long hits = stats->hits;
+    long long misses = stats->misses;
+    out << stats->name << ": " << hits << " hits, " << misses << " misses";
+    if (hits + misses > 0)
+      out << " (" << 100 * hits / (hits + misses) << "% hit rate)";
+    out << "\n";
+  }
+}
+
+long long DirtyEpoch::getNext() {
+  static atomic<long long> counter(0);
+  return ++counter;
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "util.h"
+
+/** Counts hits and misses of one memoized query. Meant to be a static object at the place where the
+    query is memoized, so that all instances of the memo share it.*/
+class MemoStats {
+  public:
+  MemoStats(const char* name);
+
+  void onHit() {
+    hits.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void onMiss() {
+    misses.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  /** Prints the counters of every memoized query that has been used so far.*/
+  static void printAll(std::ostream&);
+
+  private:
+  const char* name;
+  atomic<long long> hits;
+  atomic<long long> misses;
+};
+
+/** A number that changes whenever the state it guards changes, so that values derived from that state
+    can be memoized with the epoch as the key. The numbers are drawn from a global counter, so a new
+    or copied object never shares an epoch with another one. Epochs aren't serialized.*/
+class DirtyEpoch {
+  public:
+  DirtyEpoch() : value(getNext()) {}
+  DirtyEpoch(const DirtyEpoch&) : DirtyEpoch() {}
+
+  DirtyEpoch& operator = (const DirtyEpoch&) {
+    bump();
+    return *this;
+  }
+
+  void bump() {
+    value = getNext();
+  }
+
+  long long get() const {
+    return value;
+  }
+
+  private:
+  static long long getNext();
+  long long value;
+};
+
+/** Remembers the last computed value of a query together with the key it was computed for, and
+    recomputes it only when asked with a different key.*/
+template <typename Key, typename Value>
+class Memo {
+  public:
+  template <typename Fun>
+  const Value& get(const Key& key, MemoStats& stats, Fun compute) const {
+    if (!cached || !(cached->first == key)) {
+      stats.onMiss();
+      cached.emplace(key, compute());
+    } else
+      stats.onHit();
+    return cached->second;
+  }
+
+  void clear() {
+    cached.reset();
+  }
+
+  private:
+  mutable optional<pair<Key, Value>> cached;
+};
@@ -0,0 +1,67 @@
+#include "stdafx.h"
+#include "memory_report.h"
+#include <iomanip>
+
+MemoryReport::MemoryReport(const string& name) : name(name) {
+}
+
+MemoryReport& MemoryReport::get(const string& childName) {
+  for (auto& child : children)
+    if (child->name == childName)
+      return *child;
+  children.push_back(unique<MemoryReport>(childName));
+  return *children.back();
+}
+
+void MemoryReport::add(size_t live, size_t reserved) {
+  liveBytes += live;
+  reservedBytes += reserved;
+}
+
+void MemoryReport::add(size_t bytes) {
+  add(bytes, bytes);
+}
+
+void MemoryReport::addCount(int cnt) {
+  count += cnt;
+}
+
+size_t MemoryReport::getLiveBytes() const {
+  size_t ret = liveBytes;
+  for (auto& child : children)
+    ret += child->getLiveBytes();
+  return ret;
+}
+
+size_t MemoryReport::getReservedBytes() const {
+  size_t ret = reservedBytes;
+  for (auto& child : children)
+    ret += child->getReservedBytes();
+  return ret;
+}
+
+static string getMegabytes(size_t bytes) {
+  stringstream ss;
+  ss << std::fixed << std::setprecision(2) << double(bytes) / (1 << 20) << " MB";
+  return ss.str();
+}
+
+void MemoryReport::print(std::ostream& out, size_t minBytes) const {
+  print(out, minBytes, 0);
+}
+
+void MemoryReport::print(std::ostream& out, size_t minBytes, int depth) const {
+  out << string(2 * depth, ' ') << name << ": " << getMegabytes(getLiveBytes()) << " live, "
+      << getMegabytes(getReservedBytes()) << " reserved";
+  if (count > 0)
+    out << ", " << count << " objects";
+  out << "\n";
+  vector<const MemoryReport*> sorted;
+  for (auto& child : children)
+    if (child->getReservedBytes() >= minBytes)
+      sorted.push_back(child.get());
+  std::stable_sort(sorted.begin(), sorted.end(),
+      [](const MemoryReport* a, const MemoryReport* b) { return a->getReservedBytes() > b->getReservedBytes(); });
+  for (auto child : sorted)
+    child->print(out, minBytes, depth + 1);
+}
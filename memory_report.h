@@ -0,0 +1,44 @@
+#pragma once
+
+#include "util.h"
+
+/** A tree of the memory used by the game's structures, filled in by their reportMemory() methods. Live
+    bytes are the ones holding data, reserved bytes also include unused capacity of containers. Sizes of
+    objects that own other allocations are shallow estimates, the nested allocations are reported by
+    the objects' own entries where they matter.*/
+class MemoryReport {
+  public:
+  MemoryReport(const string& name);
+
+  /** Returns the child entry with the given name, creating it if needed.*/
+  MemoryReport& get(const string& name);
+
+  void add(size_t liveBytes, size_t reservedBytes);
+  void add(size_t bytes);
+  void addCount(int);
+
+  template <typename T>
+  void addVector(const vector<T>& v) {
+    add(v.size() * sizeof(T), v.capacity() * sizeof(T));
+  }
+
+  /** Approximates the nodes of a node based container as the element plus two pointers.*/
+  template <typename Container>
+  void addNodes(const Container& c) {
+    add(c.size() * (sizeof(typename Container::value_type) + 2 * sizeof(void*)));
+  }
+
+  size_t getLiveBytes() const;
+  size_t getReservedBytes() const;
+
+  /** Prints the tree with the biggest entries first, leaving out entries below minBytes.*/
+  void print(std::ostream&, size_t minBytes = 0) const;
+
+  private:
+  void print(std::ostream&, size_t minBytes, int depth) const;
+  string name;
+  size_t liveBytes = 0;
+  size_t reservedBytes = 0;
+  int count = 0;
+  vector<unique_ptr<MemoryReport>> children;
+};
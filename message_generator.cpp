@@ -190,7 +190,20 @@ static void addKraken(const Creature* c, MsgType type, const string& param) {
     c->message(msg);
 }
 
+bool MessageGenerator::hasAudience(const Creature* c) const {
+  switch (type) {
+    case SECOND_PERSON:
+      return true;
+    case NONE:
+      return false;
+    default:
+      return c->isPlayer() || c->getPosition().hasPlayerAudience();
+  }
+}
+
 void MessageGenerator::add(const Creature* c, MsgType msg, const string& param) {
+  if (!hasAudience(c))
+    return;
   switch (type) {
     case SECOND_PERSON:
       addSecond(c, msg, param);
@@ -210,6 +223,8 @@ void MessageGenerator::add(const Creature* c, MsgType msg, const string& param)
 }
 
 void MessageGenerator::add(const Creature* c, const string& param) {
+  if (!hasAudience(c))
+    return;
   switch (type) {
     case SECOND_PERSON:
       addSecond(c, param);
@@ -227,11 +242,21 @@ void MessageGenerator::addThirdPerson(const Creature* c, const PlayerMessage& ms
     c->message(msg);
 }
 
+void MessageGenerator::addThirdPerson(const Creature* c, const function<PlayerMessage()>& msg) {
+  if (type == THIRD_PERSON && hasAudience(c))
+    c->message(msg());
+}
+
 void MessageGenerator::addSecondPerson(const Creature* c, const PlayerMessage& msg) {
   if (type == SECOND_PERSON)
     c->message(msg);
 }
 
+void MessageGenerator::addSecondPerson(const Creature* c, const function<PlayerMessage()>& msg) {
+  if (type == SECOND_PERSON)
+    c->message(msg());
+}
+
 string MessageGenerator::getEnemyName(const Creature* c) {
   if (type == SECOND_PERSON)
     return "you";
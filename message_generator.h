@@ -14,8 +14,13 @@ class MessageGenerator {
   void add(const Creature*, MsgType, const string&);
   void add(const Creature*, const string&);
   void addThirdPerson(const Creature*, const PlayerMessage&);
+  /** Formats the message only if it would be received.*/
+  void addThirdPerson(const Creature*, const function<PlayerMessage()>&);
   void addSecondPerson(const Creature*, const PlayerMessage&);
+  void addSecondPerson(const Creature*, const function<PlayerMessage()>&);
   string getEnemyName(const Creature*);
+  /** Returns false if nobody would receive messages about the creature.*/
+  bool hasAudience(const Creature*) const;
 
   SERIALIZATION_DECL(MessageGenerator)
 
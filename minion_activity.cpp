@@ -29,8 +29,7 @@ static bool betterPos(Position from, Position current, Position candidate) {
 
 static optional<Position> getTileToExplore(WCollective collective, const Creature* c, MinionActivity task) {
   auto& borderTiles = collective->getKnownTiles().getBorderTiles();
-  auto blockName = "get tile to explore " + toString(borderTiles.size());
-  PROFILE_BLOCK(blockName.data());
+  PROFILE_BLOCK("get tile to explore");
   auto movementType = c->getMovementType();
   optional<Position> caveTile;
   optional<Position> outdoorTile;
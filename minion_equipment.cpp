@@ -28,6 +28,7 @@
 #include "weapon_info.h"
 #include "minion_equipment_type.h"
 #include "health_type.h"
+#include "entity_set.h"
 
 template <class Archive>
 void MinionEquipment::serialize(Archive& ar, const unsigned int) {
@@ -79,34 +80,60 @@ bool MinionEquipment::canUseItemType(const Creature* c, MinionEquipmentType type
   }
 }
 
+// Values of items for a single creature, each computed at most once during an assignment pass. They aren't
+// kept between passes, because the creature's attributes and the items' modifiers change without notice.
+class MinionEquipment::ItemValues {
+  public:
+  ItemValues(const MinionEquipment& equipment, const Creature* creature)
+      : equipment(equipment), creature(creature) {}
+
+  int get(const Item* it) {
+    auto iter = values.find(it);
+    if (iter == values.end())
+      iter = values.insert(make_pair(it, equipment.getItemValue(creature, it))).first;
+    return iter->second;
+  }
+
+  private:
+  const MinionEquipment& equipment;
+  const Creature* creature;
+  unordered_map<const Item*, int> values;
+};
+
+const static vector<WeakPointer<Item>> emptyItems;
+
 bool MinionEquipment::needsItem(const Creature* c, const Item* it, bool noLimit) const {
+  if (noLimit) {
+    auto type = getEquipmentType(it);
+    return type && canUseItemType(c, *type, it);
+  }
+  ItemValues values(*this, c);
+  return needsItem(c, it, values);
+}
+
+bool MinionEquipment::needsItem(const Creature* c, const Item* it, ItemValues& values) const {
   PROFILE;
   if (optional<MinionEquipmentType> type = getEquipmentType(it)) {
     if (!canUseItemType(c, *type, it))
       return false;
-    if (!noLimit) {
-      auto itemValue = getItemValue(c, it);
-      if (auto limit = getEquipmentLimit(*type)) {
-        auto pred = [=](const Item* ownedItem) {
-          return getEquipmentType(ownedItem) == *type &&
-              (getItemValue(c, ownedItem) >= itemValue || isLocked(c, ownedItem->getUniqueId())) &&
-              ownedItem != it;
-        };
-        if (getItemsOwnedBy(c, pred).size() >= *limit)
-          return false;
-      }
-      if (it->canEquip()) {
-        auto slot = it->getEquipmentSlot();
-        int limit = c->getEquipment().getMaxItems(slot, c);
-        auto pred = [=](const Item* ownedItem) {
-          return ownedItem->canEquip() &&
-              ownedItem->getEquipmentSlot() == slot &&
-              (getItemValue(c, ownedItem) >= itemValue || isLocked(c, ownedItem->getUniqueId())) &&
-              ownedItem != it;
-        };
-        if (getItemsOwnedBy(c, pred).size() >= limit)
-          return false;
-      }
+    auto itemValue = values.get(it);
+    auto countBetterOwned = [&](auto predicate) {
+      int ret = 0;
+      for (auto& ownedItem : myItems.getOrElse(c, emptyItems))
+        if (ownedItem && ownedItem.get() != it && predicate(ownedItem.get()) &&
+            (values.get(ownedItem.get()) >= itemValue || isLocked(c, ownedItem->getUniqueId())))
+          ++ret;
+      return ret;
+    };
+    if (auto limit = getEquipmentLimit(*type))
+      if (countBetterOwned([&](const Item* ownedItem) { return getEquipmentType(ownedItem) == *type; }) >= *limit)
+        return false;
+    if (it->canEquip()) {
+      auto slot = it->getEquipmentSlot();
+      int limit = c->getEquipment().getMaxItems(slot, c);
+      if (countBetterOwned([&](const Item* ownedItem) {
+            return ownedItem->canEquip() && ownedItem->getEquipmentSlot() == slot; }) >= limit)
+        return false;
     }
     return true;
   } else
@@ -124,33 +151,45 @@ bool MinionEquipment::isOwner(const Item* it, const Creature* c) const {
   return getOwner(it) == c->getUniqueId();
 }
 
-const static vector<WeakPointer<Item>> emptyItems;
-
 void MinionEquipment::updateOwners(const vector<Creature*>& creatures) {
-  auto oldItemMap = myItems;
-  myItems.clear();
-  owners.clear();
+  // Creatures that leave are normally removed with removeOwner(), this catches any that weren't.
+  EntitySet<Creature> current(creatures);
+  for (auto id : myItems.getKeys())
+    if (!current.contains(id)) {
+      for (auto& item : myItems.getOrFail(id))
+        if (item) {
+          owners.erase(item->getUniqueId());
+          locked.erase(make_pair(id, item->getUniqueId()));
+        }
+      myItems.erase(id);
+    }
   for (auto c : creatures)
-    for (auto item : oldItemMap.getOrElse(c, emptyItems))
-      if (item) {
-        owners.set(item, c->getUniqueId());
-        myItems.getOrInit(c).push_back(item);
-      }
+    if (myItems.hasKey(c)) {
+      auto& items = myItems.getOrFail(c);
+      for (int i = items.size() - 1; i >= 0; --i)
+        if (!items[i])
+          items.removeIndexPreserveOrder(i);
+    }
   for (auto c : creatures)
     for (auto item : getItemsOwnedBy(c))
       if (!needsItem(c, item))
         discard(item);
 }
 
+void MinionEquipment::removeOwner(const Creature* c) {
+  for (auto item : getItemsOwnedBy(c))
+    discard(item);
+  myItems.erase(c);
+}
+
 void MinionEquipment::updateItems(const vector<Item*>& items) {
-  auto oldOwners = owners;
-  myItems.clear();
-  owners.clear();
-  for (auto it : items)
-    if (auto owner = oldOwners.getMaybe(it)) {
-      myItems.getOrInit(*owner).push_back(it);
-      owners.set(it->getUniqueId(), *owner);
-    }
+  EntitySet<Item> current(items);
+  vector<UniqueEntity<Item>::Id> lost;
+  for (auto& elem : owners)
+    if (!current.contains(elem.first))
+      lost.push_back(elem.first);
+  for (auto id : lost)
+    discard(id);
 }
 
 vector<Item*> MinionEquipment::getItemsOwnedBy(const Creature* c, ItemPredicate predicate) const {
@@ -182,11 +221,16 @@ void MinionEquipment::discard(UniqueEntity<Item>::Id id) {
 }
 
 void MinionEquipment::sortByEquipmentValue(const Creature* c, vector<Item*>& items) const {
+  ItemValues values(*this, c);
+  sortByEquipmentValue(items, values);
+}
+
+void MinionEquipment::sortByEquipmentValue(vector<Item*>& items, ItemValues& itemValues) const {
   PROFILE;
   vector<int> values;
   vector<int> indexes;
   for (auto& item : items) {
-    values.push_back(getItemValue(c, item));
+    values.push_back(itemValues.get(item));
     indexes.push_back(indexes.size());
   }
   sort(indexes.begin(), indexes.end(), [&](int index1, int index2) {
@@ -227,12 +271,12 @@ bool MinionEquipment::tryToOwn(const Creature* c, Item* it) {
   return true;
 }
 
-Item* MinionEquipment::getWorstItem(const Creature* c, vector<Item*> items) const {
+Item* MinionEquipment::getWorstItem(const Creature* c, vector<Item*> items, ItemValues& values) const {
   PROFILE;
   Item* ret = nullptr;
   for (Item* it : items)
     if (!isLocked(c, it->getUniqueId()) &&
-        (!ret || getItemValue(c, it) < getItemValue(c, ret)))
+        (!ret || values.get(it) < values.get(ret)))
       ret = it;
   return ret;
 }
@@ -252,18 +296,21 @@ void MinionEquipment::autoAssign(const Creature* creature, vector<Item*> possibl
       EquipmentSlot slot = it->getEquipmentSlot();
       slots[slot].push_back(it);
     }
-  sortByEquipmentValue(creature, possibleItems);
+  // Only unowned items can be assigned, so don't bother valuing and sorting the rest.
+  possibleItems = possibleItems.filter([this] (const Item* it) { return !getOwner(it) && canAutoAssignItem(it); });
+  ItemValues values(*this, creature);
+  sortByEquipmentValue(possibleItems, values);
   for (Item* it : possibleItems)
-    if (!getOwner(it) && needsItem(creature, it) && canAutoAssignItem(it)) {
+    if (!getOwner(it) && needsItem(creature, it, values)) {
       if (!it->canEquip()) {
         CHECK(tryToOwn(creature, it));
         continue;
       }
-      Item* replacedItem = getWorstItem(creature, slots[it->getEquipmentSlot()]);
+      Item* replacedItem = getWorstItem(creature, slots[it->getEquipmentSlot()], values);
       int slotSize = creature->getEquipment().getMaxItems(it->getEquipmentSlot(), creature);
       int numInSlot = slots[it->getEquipmentSlot()].size();
       if (numInSlot < slotSize ||
-          (replacedItem && getItemValue(creature, replacedItem) < getItemValue(creature, it))) {
+          (replacedItem && values.get(replacedItem) < values.get(it))) {
         if (numInSlot == slotSize) {
           discard(replacedItem);
           slots[it->getEquipmentSlot()].removeElement(replacedItem);
@@ -33,6 +33,7 @@ class MinionEquipment {
   void discard(const Item*);
   void discard(UniqueEntity<Item>::Id);
   void updateOwners(const vector<Creature*>&);
+  void removeOwner(const Creature*);
   vector<Item*> getItemsOwnedBy(const Creature*, ItemPredicate = nullptr) const;
 
   template <class Archive>
@@ -45,9 +46,12 @@ class MinionEquipment {
   void updateItems(const vector<Item*>& items);
 
   private:
+  class ItemValues;
+  bool needsItem(const Creature*, const Item*, ItemValues&) const;
+  void sortByEquipmentValue(vector<Item*>& items, ItemValues&) const;
   static optional<MinionEquipmentType> getEquipmentType(const Item* it);
   optional<int> getEquipmentLimit(MinionEquipmentType type) const;
-  Item* getWorstItem(const Creature*, vector<Item*>) const;
+  Item* getWorstItem(const Creature*, vector<Item*>, ItemValues&) const;
   int getItemValue(const Creature*, const Item*) const;
   bool canUseItemType(const Creature*, MinionEquipmentType, const Item*) const;
 
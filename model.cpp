@@ -56,6 +56,8 @@
 #include "avatar_info.h"
 #include "collective_config.h"
 #include "biome_id.h"
+#include "vision.h"
+#include "memory_report.h"
 
 template <class Archive> 
 void Model::serialize(Archive& ar, const unsigned int version) {
@@ -118,9 +120,33 @@ void Model::checkCreatureConsistency() {
   }
 }
 
+unique_ptr<WorkerPool> Model::turnWorkers;
+
+void Model::setNumTurnThreads(int num) {
+  // The thread that runs the game takes part in every job.
+  turnWorkers.reset(num > 1 ? new WorkerPool(num - 1) : nullptr);
+}
+
+void Model::prepareTurn() {
+  PROFILE;
+  map<pair<WLevel, VisionId>, vector<Vec2>> positions;
+  for (auto c : timeQueue->getCreaturesMovingNow())
+    if (auto level = c->getLevel())
+      positions[make_pair(level, c->getVision().getId())].push_back(c->getPosition().getCoord());
+  for (auto& elem : positions)
+    elem.first.first->precomputeVisibility(elem.second, elem.first.second, *turnWorkers);
+}
+
 bool Model::update(double totalTime) {
   currentTime = totalTime;
   if (Creature* creature = timeQueue->getNextCreature(totalTime)) {
+    if (turnWorkers) {
+      auto turn = make_pair(timeQueue->getTime(creature), timeQueue->hasExtraMove(creature));
+      if (turn != preparedTurn) {
+        preparedTurn = turn;
+        prepareTurn();
+      }
+    }
     CHECK(creature->getLevel() != nullptr) << "Creature misplaced before processing: " << creature->getName().bare() <<
         ". Any idea why this happened?";
     if (creature->isDead()) {
@@ -275,6 +301,11 @@ vector<WLevel> Model::getLevels() const {
   return getWeakPointers(levels);
 }
 
+void Model::reportMemory(MemoryReport& report) const {
+  for (auto& level : levels)
+    level->reportMemory(report.get("levels"));
+}
+
 const vector<WLevel>& Model::getMainLevels() const {
   return mainLevels;
 }
@@ -36,6 +36,7 @@ class Options;
 class AvatarInfo;
 class GameConfig;
 class ContentFactory;
+class MemoryReport;
 
 /**
   * Main class that holds all game logic.
@@ -48,6 +49,10 @@ class Model : public OwnedObject<Model> {
     Returns the total logical time elapsed.*/
   bool update(double totalTime);
 
+  /** With more than one thread, the field of view of all creatures due to move at a given time is computed
+    in parallel before the first of them moves. The moves themselves are still decided and made one by one.*/
+  static void setNumTurnThreads(int);
+
   /** Returns the level that the stairs lead to. */
   WLevel getLinkedLevel(WLevel from, StairKey) const;
 
@@ -75,6 +80,7 @@ class Model : public OwnedObject<Model> {
   vector<Creature*> getAllCreatures() const;
   const vector<PCreature>& getDeadCreatures() const;
   vector<WLevel> getLevels() const;
+  void reportMemory(MemoryReport&) const;
   const vector<WLevel>& getMainLevels() const;
   void addCollective(PCollective);
 
@@ -137,5 +143,8 @@ class Model : public OwnedObject<Model> {
   heap_optional<ExternalEnemies> SERIAL(externalEnemies);
   int moveCounter = 0;
   BiomeId SERIAL(biome);
+  void prepareTurn();
+  optional<pair<LocalTime, bool>> preparedTurn;
+  static unique_ptr<WorkerPool> turnWorkers;
 };
 
@@ -81,9 +81,9 @@ void ModelBuilder::makeExtraLevel(WModel model, LevelConnection& connection, Set
         settlement.downStairs = {downLink};
       if (connection.direction == LevelConnectionDir::UP)
         swap(settlement.upStairs, settlement.downStairs);
-      model->buildLevel(
-          LevelBuilder(meter, random, contentFactory, level.levelSize.x, level.levelSize.y),
-          getMaker(level.levelType)(random, settlement));
+      LevelBuilder builder(meter, random, contentFactory, level.levelSize.x, level.levelSize.y);
+      builder.setStats(levelGenStats);
+      model->buildLevel(std::move(builder), getMaker(level.levelType)(random, settlement));
       upLink = downLink;
       downLink = StairKey::getNew();
     };
@@ -412,6 +412,8 @@ void ModelBuilder::measureModelGen(const string& name, int numTries, function<vo
   int maxT = 0;
   int minT = 1000000;
   double sumT = 0;
+  LevelGenStats stats;
+  levelGenStats = &stats;
   std::cout << name;
   for (int i : Range(numTries)) {
 #ifndef OSX // this triggers some compiler errors OSX, I don't need it there anyway.
@@ -433,8 +435,10 @@ void ModelBuilder::measureModelGen(const string& name, int numTries, function<vo
     minT = min(minT, millis);
 #endif
   }
+  levelGenStats = nullptr;
   std::cout << std::endl << numSuccess << " / " << numTries << ". MinT: " <<
     minT << ". MaxT: " << maxT << ". AvgT: " << sumT / numTries << std::endl;
+  stats.print(std::cout);
 }
 
 static optional<CreatureGroup> getWildlife(BiomeId id) {
@@ -484,8 +488,9 @@ PModel ModelBuilder::tryModel(int width, vector<EnemyInfo> enemyInfo, optional<T
   optional<CreatureGroup> wildlife;
   if (hasWildlife)
     wildlife = getWildlife(biomeId);
-  model->buildMainLevel(
-      LevelBuilder(meter, random, contentFactory, width, width, false),
+  LevelBuilder builder(meter, random, contentFactory, width, width, false);
+  builder.setStats(levelGenStats);
+  model->buildMainLevel(std::move(builder),
       LevelMaker::topLevel(random, wildlife, topLevelSettlements, width,
         keeperTribe, biomeId, *chooseResourceCounts(random, contentFactory->resources, 0)));
   model->calculateStairNavigation();
@@ -21,6 +21,7 @@ class CreatureList;
 class GameConfig;
 class ContentFactory;
 struct LevelConnection;
+struct LevelGenStats;
 
 class ModelBuilder {
   public:
@@ -58,6 +59,7 @@ class ModelBuilder {
   vector<EnemyInfo> getSingleMapEnemiesForEvilKeeper(TribeId keeperTribe);
   vector<EnemyInfo> getSingleMapEnemiesForLawfulKeeper(TribeId keeperTribe);
   ContentFactory* contentFactory = nullptr;
+  LevelGenStats* levelGenStats = nullptr;
   using LevelMakerMethod = function<PLevelMaker(RandomGen&, SettlementInfo)>;
   LevelMakerMethod getMaker(LevelType);
 };
@@ -48,7 +48,6 @@
 #include "navigation_flags.h"
 #include "furniture_tick.h"
 #include "time_queue.h"
-#include "draw_line.h"
 #include "furniture_entry.h"
 #include "spell_map.h"
 #include "vision.h"
@@ -135,14 +134,9 @@ MoveInfo Behaviour::tryEffect(const Effect& type, Position target) {
   return NoMove;
 }
 
-static bool isObstructed(const Creature* creature, const vector<Position>& trajectory) {
-  vector<Creature*> ret;
-  for (int i : Range(1, trajectory.size())) {
-    auto& pos = trajectory[i];
-    if (pos.stopsProjectiles(creature->getVision().getId()) || (pos.getCreature() && pos != trajectory.back()))
-      return true;
-  }
-  return false;
+static bool isObstructed(const Creature* creature, Position target) {
+  return target.getLevel()->isLineOfFireObstructed(creature->getPosition().getCoord(), target.getCoord(),
+      creature->getVision().getId());
 }
 
 class EffectsAI : public Behaviour {
@@ -156,21 +150,25 @@ class EffectsAI : public Behaviour {
     return 0;
   }
 
-  MoveInfo getThrowMove(Creature* other) {
+  vector<Item*> getThrowableItems() {
+    return creature->getEquipment().getItems().filter([&](const Item* item) {
+      return item->effectAppliedWhenThrown() && !!item->getEffect() && !creature->getEquipment().isEquipped(item);
+    });
+  }
+
+  MoveInfo getThrowMove(Creature* other, const vector<Item*>& throwable) {
     auto target = other->getPosition();
-    auto trajectory = drawLine(creature->getPosition().getCoord(), target.getCoord())
-        .transform([&](Vec2 v) { return Position(v, target.getLevel()); });
-    if (isObstructed(creature, trajectory))
+    int distance = target.dist8(creature->getPosition()).value_or(10000);
+    auto items = throwable.filter([&](const Item* item) {
+      return item->getEffect()->shouldAIApply(creature, target) == EffectAIIntent::WANTED &&
+          creature->getThrowDistance(item).value_or(-1) >= distance;
+    });
+    // The line of fire is only checked if there is something worth throwing at this target.
+    if (items.empty() || isObstructed(creature, target))
       return NoMove;
-    for (auto item : creature->getEquipment().getItems())
-      if (item->effectAppliedWhenThrown())
-        if (auto effect = item->getEffect())
-          if (effect->shouldAIApply(creature, target) == EffectAIIntent::WANTED)
-            if (!creature->getEquipment().isEquipped(item) &&
-               creature->getThrowDistance(item).value_or(-1) >=
-                   trajectory.back().dist8(creature->getPosition()).value_or(10000))
-              if (auto action = creature->throwItem(item, target, creature->isFriend(other)))
-                return action;
+    for (auto item : items)
+      if (auto action = creature->throwItem(item, target, creature->isFriend(other)))
+        return action;
     return NoMove;
   }
 
@@ -193,9 +191,11 @@ class EffectsAI : public Behaviour {
                 if (auto action = creature->give(c, {item}))
                   return MoveInfo(0.5, action);
         }
-    for (auto c : creature->getVisibleCreatures())
-      if (auto move = getThrowMove(c))
-        return move;
+    auto throwable = getThrowableItems();
+    if (!throwable.empty())
+      for (auto c : creature->getVisibleCreatures())
+        if (auto move = getThrowMove(c, throwable))
+          return move;
     return NoMove;
   }
 
@@ -450,12 +450,8 @@ class Fighter : public Behaviour {
 
   MoveInfo getFireMove(Creature* enemy) {
     auto target = enemy->getPosition();
-    auto trajectory = drawLine(creature->getPosition().getCoord(), target.getCoord())
-        .transform([&](Vec2 v) { return Position(v, target.getLevel()); });
-    if (isObstructed(creature, trajectory))
-      return NoMove;
-    int dist = *trajectory.back().dist8(creature->getPosition());
-    if (dist <= getFiringRange(creature))
+    int dist = *target.dist8(creature->getPosition());
+    if (dist <= getFiringRange(creature) && !isObstructed(creature, target))
       if (auto action = creature->fire(target))
         return {1.0, action.append([=](Creature*) {
             addCombatIntent(enemy, true);
@@ -25,7 +25,7 @@ class NameGenerator {
   void setNames(NameGeneratorId, vector<string> names);
   string getNext(NameGeneratorId);
   vector<string> getAll(NameGeneratorId);
-  NameGenerator(const NameGenerator&) = delete;
+  NameGenerator(const NameGenerator&) = default;
   NameGenerator(NameGenerator&&) = default;
 
   template <typename Archive>
@@ -0,0 +1,71 @@
+#include "stdafx.h"
+#include "object_pool.h"
+#include "debug.h"
+#include "memory_report.h"
+
+static recursive_mutex allPoolsMutex;
+
+// Pools are intentionally leaked, so that objects destroyed during static destruction can still be freed.
+static map<pair<string, size_t>, ObjectPool*>& getAllPools() {
+  static map<pair<string, size_t>, ObjectPool*> ret;
+  return ret;
+}
+
+// Small sizes are spaced by the alignment of the blocks, larger ones more coarsely, so that for example
+// the control blocks of all Item subclasses of similar size end up in one pool.
+static size_t getSizeClass(size_t size) {
+  // Every block must be able to hold the free list pointer, and the next block must stay aligned.
+  size = max(size, sizeof(void*));
+  const size_t step = size <= 256 ? alignof(std::max_align_t) : 64;
+  return (size + step - 1) / step * step;
+}
+
+ObjectPool& ObjectPool::get(const char* name, size_t size, size_t alignment) {
+  CHECK(alignment <= alignof(std::max_align_t)) << "Over-aligned type in pool " << name;
+  auto blockSize = getSizeClass(size);
+  RecursiveLock lock(allPoolsMutex);
+  auto& pool = getAllPools()[make_pair(string(name), blockSize)];
+  if (!pool)
+    pool = new ObjectPool(name, blockSize);
+  return *pool;
+}
+
+ObjectPool::ObjectPool(const char* name, size_t size) : name(name), blockSize(size),
+    blocksPerChunk(max<int>(16, (1 << 16) / size)) {
+}
+
+void* ObjectPool::allocate() {
+  RecursiveLock lock(mutex);
+  if (!freeList) {
+    chunks.push_back(unique_ptr<char[]>(new char[blockSize * blocksPerChunk]));
+    // Thread the blocks in address order, so that objects created one after another end up next to each other.
+    auto chunk = chunks.back().get();
+    for (int i = blocksPerChunk - 1; i >= 0; --i) {
+      void* block = chunk + i * blockSize;
+      *static_cast<void**>(block) = freeList;
+      freeList = block;
+    }
+  }
+  void* ret = freeList;
+  freeList = *static_cast<void**>(ret);
+  ++numLive;
+  return ret;
+}
+
+void ObjectPool::deallocate(void* block) {
+  RecursiveLock lock(mutex);
+  *static_cast<void**>(block) = freeList;
+  freeList = block;
+  --numLive;
+}
+
+void ObjectPool::reportMemory(MemoryReport& report) {
+  RecursiveLock lock(allPoolsMutex);
+  for (auto& elem : getAllPools()) {
+    auto pool = elem.second;
+    RecursiveLock poolLock(pool->mutex);
+    auto& entry = report.get(pool->name);
+    entry.add(pool->numLive * pool->blockSize, pool->chunks.size() * pool->blocksPerChunk * pool->blockSize);
+    entry.addCount(pool->numLive);
+  }
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "stdafx.h"
+#include "my_containers.h"
+
+class MemoryReport;
+
+/** Hands out fixed size blocks carved from large chunks, and keeps freed blocks for reuse. Objects that are
+    created and destroyed all the time then stay close together in memory and don't fragment the heap.
+    Chunks are never returned to the system. Pools live for the whole process and are never destroyed, so
+    objects may outlive everything else.*/
+class ObjectPool {
+  public:
+  /** Returns the pool for objects of the given size under the given name. Sizes are rounded up to size
+      classes, so objects of similar sizes share a pool.*/
+  static ObjectPool& get(const char* name, size_t size, size_t alignment);
+
+  void* allocate();
+  void deallocate(void*);
+
+  /** Adds an entry for every pool with the bytes used by live objects and the bytes of all chunks.*/
+  static void reportMemory(MemoryReport&);
+
+  private:
+  ObjectPool(const char* name, size_t blockSize);
+  const char* name;
+  size_t blockSize;
+  int blocksPerChunk;
+  vector<unique_ptr<char[]>> chunks;
+  void* freeList = nullptr;
+  int numLive = 0;
+  // Objects are also created and destroyed by the threads that generate levels and run simulations.
+  recursive_mutex mutex;
+};
+
+/** Allocator for std::allocate_shared that takes every type it is rebound to from the ObjectPool of its
+    size class. Pools of all rebound types are reported under the given name.*/
+template <typename T>
+class PoolAllocator {
+  public:
+  using value_type = T;
+
+  explicit PoolAllocator(const char* name) : name(name) {}
+
+  template <typename U>
+  PoolAllocator(const PoolAllocator<U>& o) : name(o.name) {}
+
+  T* allocate(size_t n) {
+    if (n != 1)
+      return static_cast<T*>(::operator new(n * sizeof(T)));
+    return static_cast<T*>(getPool().allocate());
+  }
+
+  void deallocate(T* p, size_t n) {
+    if (n != 1)
+      ::operator delete(p);
+    else
+      getPool().deallocate(p);
+  }
+
+  template <typename U>
+  bool operator == (const PoolAllocator<U>&) const {
+    return true;
+  }
+
+  template <typename U>
+  bool operator != (const PoolAllocator<U>&) const {
+    return false;
+  }
+
+  private:
+  template <typename>
+  friend class PoolAllocator;
+
+  ObjectPool& getPool() const {
+    static ObjectPool& pool = ObjectPool::get(name, sizeof(T), alignof(T));
+    return pool;
+  }
+
+  const char* name;
+};
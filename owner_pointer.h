@@ -4,6 +4,11 @@
 #include "serialization.h"
 #include "debug.h"
 #include "my_containers.h"
+#include "object_pool.h"
+
+class Creature;
+class Item;
+class Task;
 
 template <typename T>
 class WeakPointer;
@@ -245,11 +250,32 @@ T* OwnerPointer<T>::get() const {
   return elem.get();
 }
 
+// The objects that are created and destroyed all the time during a game are taken from an ObjectPool.
+template <typename T>
+using IsPooledObject = std::integral_constant<bool, std::is_base_of<Creature, T>::value ||
+    std::is_base_of<Item, T>::value || std::is_base_of<Task, T>::value>;
+
+template <typename T>
+const char* getObjectPoolName() {
+  return std::is_base_of<Creature, T>::value ? "Creature" : std::is_base_of<Item, T>::value ? "Item" : "Task";
+}
+
 template <typename T, typename... Args>
-OwnerPointer<T> makeOwner(Args&&... args) {
+OwnerPointer<T> makeOwnerImpl(std::true_type, Args&&... args) {
+  return OwnerPointer<T>(std::allocate_shared<T>(PoolAllocator<T>(getObjectPoolName<T>()),
+      std::forward<Args>(args)...));
+}
+
+template <typename T, typename... Args>
+OwnerPointer<T> makeOwnerImpl(std::false_type, Args&&... args) {
   return OwnerPointer<T>(std::make_shared<T>(std::forward<Args>(args)...));
 }
 
+template <typename T, typename... Args>
+OwnerPointer<T> makeOwner(Args&&... args) {
+  return makeOwnerImpl<T>(IsPooledObject<T>(), std::forward<Args>(args)...);
+}
+
 template<class T>
 auto getWeakPointers(const vector<OwnerPointer<T>>& v) {
   vector<decltype(v[0].get())> ret;
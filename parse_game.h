@@ -42,4 +42,69 @@ inline optional<SavedGameInfo> loadSavedGameInfo(const FilePath& filename) {
   return getSavedGameInfoUsing<CompressedInput>(filename);
 }
 
+/** Uncompressed copy of the header of a save file, kept in a small file next to it, so that the save menus
+    don't have to decompress every save. It's rebuilt from the save whenever it's missing or the save was
+    modified after it was written.*/
+struct SaveFileHeader {
+  int SERIAL(version);
+  string SERIAL(name);
+  SavedGameInfo SERIAL(info);
+  // Modification time of the save file that this header was written for.
+  long long SERIAL(saveTime);
+  SERIALIZE_ALL(version, name, info, saveTime)
+};
 
+// Bump when SaveFileHeader or SavedGameInfo changes, so that old header files are rebuilt.
+constexpr int saveFileHeaderFormat = 1;
+
+inline FilePath getSaveFileHeaderPath(const FilePath& save) {
+  return FilePath::fromFullPath(save.getPath() + string(".hdr"));
+}
+
+inline void writeSaveFileHeader(const FilePath& save, SaveFileHeader header) {
+  try {
+    header.saveTime = save.getModificationTime();
+    StreamCombiner<ofstream, OutputArchive> out(getSaveFileHeaderPath(save).getPath(), std::ios::binary);
+    out.getArchive() << saveFileHeaderFormat << header;
+  } catch (std::exception&) {
+  }
+}
+
+inline optional<SaveFileHeader> loadSaveFileHeader(const FilePath& save) {
+  if (!save.exists())
+    return none;
+  auto headerPath = getSaveFileHeaderPath(save);
+  if (headerPath.exists())
+    try {
+      StreamCombiner<ifstream, InputArchive> in(headerPath.getPath(), std::ios::binary);
+      int format;
+      SaveFileHeader ret;
+      in.getArchive() >> format;
+      if (format == saveFileHeaderFormat) {
+        in.getArchive() >> ret;
+        if (ret.saveTime == save.getModificationTime())
+          return ret;
+      }
+    } catch (std::exception&) {
+    }
+  try {
+    CompressedInput input(save.getPath());
+    SaveFileHeader ret;
+    input.getArchive() >> ret.version >> ret.name >> ret.info;
+    writeSaveFileHeader(save, ret);
+    return ret;
+  } catch (std::exception&) {
+    return none;
+  }
+}
+
+inline void removeSaveFile(const FilePath& save) {
+  remove(save.getPath());
+  remove(getSaveFileHeaderPath(save).getPath());
+}
+
+inline void renameSaveFile(const FilePath& from, const FilePath& to) {
+  removeSaveFile(to);
+  rename(from.getPath(), to.getPath());
+  rename(getSaveFileHeaderPath(from).getPath(), getSaveFileHeaderPath(to).getPath());
+}
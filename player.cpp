@@ -667,7 +667,7 @@ void Player::makeMove() {
     displayGreeting = false;
     getView()->updateView(this, false);
   }
-  UserInput action = getView()->getAction();
+  UserInput action = getGame()->getAction();
   if (travelling && action.getId() == UserInputId::IDLE)
     travelAction();
   else if (target && action.getId() == UserInputId::IDLE)
@@ -2703,7 +2703,7 @@ WLevel PlayerControl::getCurrentLevel() const {
 bool PlayerControl::isConsideredAttacking(const Creature* c, WConstCollective enemy) {
   if (enemy && enemy->getModel() == getModel())
     return canSee(c) && (collective->getTerritory().contains(c->getPosition()) ||
-        collective->getTerritory().getStandardExtended().contains(c->getPosition()));
+        collective->getTerritory().isInStandardExtended(c->getPosition()));
   else
     return canSee(c) && c->getLevel()->getModel() == getModel();
 }
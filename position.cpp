@@ -285,6 +285,17 @@ void Position::globalMessage(const PlayerMessage& msg) const {
       }
 }
 
+bool Position::hasPlayerAudience() const {
+  PROFILE;
+  if (isValid())
+    if (auto game = getGame())
+      for (auto player : game->getPlayerCreatures())
+        if (player->getLevel() == level &&
+            (dist8(player->getPosition()).value_or(10000) < hearingRange || player->canSee(*this)))
+          return true;
+  return false;
+}
+
 vector<Position> Position::neighbors8() const {
   //PROFILE;
   vector<Position> ret;
@@ -642,6 +653,8 @@ void Position::removeFurniture(WConstFurniture f, PFurniture replace) const {
       addFurnitureEffect(replacePtr->getTribe(), *effect);
   } else {
     level->furniture->getBuilt(layer).clearElem(coord);
+    if (layer == FurnitureLayer::MIDDLE)
+      level->updateLineOfFire(coord);
     level->furniture->getConstruction(coord, layer).reset();
   }
   updateMovementDueToFire();
@@ -54,6 +54,9 @@ class Position {
   Position minus(Vec2) const;
   void unseenMessage(const PlayerMessage&) const;
   void globalMessage(const PlayerMessage&) const;
+  /** Returns true if a player creature can see or hear this position. Messages about other positions are
+      dropped, so they don't need to be formatted.*/
+  bool hasPlayerAudience() const;
   vector<Position> neighbors8() const;
   vector<Position> neighbors4() const;
   vector<Position> neighbors8(RandomGen&) const;
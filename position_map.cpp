@@ -9,6 +9,7 @@
 #include "furniture_layer.h"
 #include "construction_map.h"
 #include "zones.h"
+#include "memory_report.h"
 
 template <typename T>
 static optional<T&> getReferenceOptional(optional<T>& t) {
@@ -167,6 +168,14 @@ void PositionMap<T>::serialize(Archive& ar, const unsigned int version) {
   ar(tables, outliers);
 }
 
+template <class T>
+void PositionMap<T>::reportMemory(MemoryReport& report) const {
+  for (auto& table : tables)
+    report.add(table.second.getMemoryBytes());
+  for (auto& elem : outliers)
+    report.addNodes(elem.second);
+}
+
 template <class T>
 SERIALIZATION_CONSTRUCTOR_IMPL2(PositionMap<T>, PositionMap)
 
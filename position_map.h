@@ -4,6 +4,7 @@
 #include "position.h"
 
 class Level;
+class MemoryReport;
 
 template <class T>
 class PositionMap {
@@ -18,6 +19,7 @@ class PositionMap {
   void set(Position, const T&);
   void erase(Position);
   void limitToModel(const WModel);
+  void reportMemory(MemoryReport&) const;
 
   SERIALIZATION_DECL(PositionMap);
 
@@ -2,7 +2,8 @@
 #include "movement_type.h"
 
 
-optional<Position> PositionMatching::getMatch(Position pos) const {
+optional<Position> PositionMatching::getMatch(Position pos) {
+  processPending();
   return matches.getValueMaybe(pos);
 }
 
@@ -10,28 +11,41 @@ void PositionMatching::releaseTarget(Position pos) {
   targets.erase(pos);
   if (auto match = matches.getValueMaybe(pos)) {
     removeMatch(pos);
-    findPath(*match);
+    pendingSquares.push_back(*match);
   }
 }
 
 void PositionMatching::addTarget(Position pos) {
   targets.insert(pos);
-  findPath(pos);
+  pendingTargets.push_back(pos);
 }
 
 static bool isOpen(Position pos) {
   return pos.canEnterEmpty({MovementTrait::WALK});
 }
 
+bool PositionMatching::isSquare(Position pos) const {
+  return !targets.count(pos) && isOpen(pos);
+}
+
+bool PositionMatching::hasNeighborTarget(Position pos) const {
+  for (auto v : pos.neighbors8())
+    if (targets.count(v))
+      return true;
+  return false;
+}
+
 void PositionMatching::updateMovement(Position pos) {
   if (targets.count(pos))
     releaseTarget(pos);
-  if (isOpen(pos))
-    findPath(pos);
-  else {
+  if (isOpen(pos)) {
+    // A square that is already matched stays matched, and one without targets around can't be matched.
+    if (!reverseMatches.contains(pos) && hasNeighborTarget(pos))
+      pendingSquares.push_back(pos);
+  } else {
     if (auto match = reverseMatches.getValueMaybe(pos)) {
       removeMatch(pos);
-      findPath(*match);
+      pendingTargets.push_back(*match);
     }
   }
 }
@@ -40,12 +54,10 @@ void PositionMatching::removeMatch(Position pos) {
   if (auto match = matches.getValueMaybe(pos)) {
     reverseMatches.erase(*match);
     matches.erase(pos);
-    //std::cout << "Removed match " << pos.getCoord() << " " << match->getCoord() << std::endl;
   }
   if (auto match = reverseMatches.getValueMaybe(pos)) {
     matches.erase(*match);
     reverseMatches.erase(pos);
-    //std::cout << "Removed match " << pos.getCoord() << " " << match->getCoord() << std::endl;
   }
 }
 
@@ -58,30 +70,143 @@ void PositionMatching::setMatch(Position pos1, Position pos2) {
   removeMatch(pos2);
   matches.set(pos1, pos2);
   reverseMatches.set(pos2, pos1);
-  //std::cout << "Added match " << pos1.getCoord() << " " << pos2.getCoord() << std::endl;
-}
-
-void PositionMatching::findPath(Position pos) {
-  PositionSet visited;
-  findPath(pos, visited, true);
-}
-
-bool PositionMatching::findPath(Position pos, PositionSet& visited, bool matchedWithFather) {
-  if (visited.count(pos))
-    return false;
-  visited.insert(pos);
-  bool isTarget = targets.count(pos);
-  auto match = isTarget ? matches.getValueMaybe(pos) : reverseMatches.getValueMaybe(pos);
-  if (matchedWithFather) {
-    for (auto candidate : pos.neighbors8())
-      if (((isTarget && isOpen(candidate)) || (!isTarget && targets.count(candidate))) &&
-          findPath(candidate, visited, false)) {
-        setMatch(pos, candidate);
-        return true;
+}
+
+vector<Position> PositionMatching::getNeighbors(Position pos, bool isTarget) const {
+  return pos.neighbors8().filter([&](Position v) { return isTarget ? isSquare(v) : !!targets.count(v); });
+}
+
+optional<Position> PositionMatching::getPartner(Position pos, bool isTarget) const {
+  return isTarget ? matches.getValueMaybe(pos) : reverseMatches.getValueMaybe(pos);
+}
+
+optional<int> PositionMatching::getLayer(Position pos) const {
+  if (auto label = labels.getValueMaybe(pos))
+    if (*label >= labelBase)
+      return *label - labelBase;
+  return none;
+}
+
+void PositionMatching::setLayer(Position pos, int layer) {
+  labels.set(pos, labelBase + layer);
+}
+
+void PositionMatching::removeLayer(Position pos) {
+  labels.set(pos, labelBase - 1);
+}
+
+void PositionMatching::processPending() {
+  auto sources = pendingTargets.filter([&](Position pos) { return !!targets.count(pos); });
+  auto squares = pendingSquares.filter([&](Position pos) { return isSquare(pos); });
+  pendingTargets.clear();
+  pendingSquares.clear();
+  if (sources.empty())
+    while (runPhase(squares, false)) {}
+  else {
+    // The phases must start on one side. Searching from the targets alone could take a pending square
+    // that another free target needed, so the free targets that can reach the pending squares are added.
+    append(sources, getFreeTargetsReachableFrom(squares));
+    while (runPhase(sources, true)) {}
+  }
+}
+
+vector<Position> PositionMatching::getFreeTargetsReachableFrom(const vector<Position>& squares) {
+  vector<Position> ret;
+  vector<Position> queue;
+  for (auto& pos : squares)
+    if (!getPartner(pos, false) && !getLayer(pos)) {
+      setLayer(pos, 0);
+      queue.push_back(pos);
+    }
+  for (int i = 0; i < queue.size(); ++i)
+    for (auto target : getNeighbors(queue[i], false))
+      if (!getLayer(target)) {
+        setLayer(target, 0);
+        if (auto partner = getPartner(target, true)) {
+          if (!getLayer(*partner)) {
+            setLayer(*partner, 0);
+            queue.push_back(*partner);
+          }
+        } else
+          ret.push_back(target);
       }
-    return false;
-  } else
-    return (!match || findPath(*match, visited, true));
+  labelBase += 2;
+  return ret;
+}
+
+// One Hopcroft-Karp phase. The BFS stops at the first layer that reaches a free vertex, so a search only
+// looks as far as the shortest augmenting path. Returns false if no path was found.
+bool PositionMatching::runPhase(const vector<Position>& sources, bool fromTargets) {
+  if (labelBase > (1 << 30)) {
+    labels = PositionMap<int>();
+    labelBase = 0;
+  }
+  vector<Position> queue;
+  for (auto& pos : sources)
+    if (!getPartner(pos, fromTargets) && !getLayer(pos)) {
+      setLayer(pos, 0);
+      queue.push_back(pos);
+    }
+  optional<int> freeLayer;
+  int maxLayer = 0;
+  for (int i = 0; i < queue.size(); ++i) {
+    auto pos = queue[i];
+    int layer = *getLayer(pos);
+    if (freeLayer && layer > *freeLayer)
+      break;
+    for (auto v : getNeighbors(pos, fromTargets))
+      if (auto partner = getPartner(v, !fromTargets)) {
+        if (!getLayer(*partner)) {
+          setLayer(*partner, layer + 1);
+          maxLayer = max(maxLayer, layer + 1);
+          queue.push_back(*partner);
+        }
+      } else if (!freeLayer)
+        freeLayer = layer;
+  }
+  bool augmented = false;
+  if (freeLayer) {
+    struct Frame {
+      Position pos;
+      vector<Position> neighbors;
+      int index;
+    };
+    for (auto& source : sources)
+      if (getLayer(source) == optional<int>(0) && !getPartner(source, fromTargets)) {
+        vector<Frame> stack {Frame{source, getNeighbors(source, fromTargets), 0}};
+        while (!stack.empty()) {
+          auto& frame = stack.back();
+          int layer = stack.size() - 1;
+          if (frame.index == frame.neighbors.size()) {
+            // No path continues through this vertex in this phase.
+            removeLayer(frame.pos);
+            stack.pop_back();
+            continue;
+          }
+          auto v = frame.neighbors[frame.index++];
+          if (auto partner = getPartner(v, !fromTargets)) {
+            if (layer < *freeLayer && getLayer(*partner) == optional<int>(layer + 1))
+              stack.push_back(Frame{*partner, getNeighbors(*partner, fromTargets), 0});
+          } else if (layer == *freeLayer) {
+            for (auto& elem : stack) {
+              setMatch(elem.pos, elem.neighbors[elem.index - 1]);
+              removeLayer(elem.pos);
+            }
+            augmented = true;
+            break;
+          }
+        }
+      }
+  }
+  labelBase += maxLayer + 2;
+  return augmented;
+}
+
+template <typename Archive>
+void PositionMatching::serialize(Archive& ar, const unsigned) {
+  if (Archive::is_saving::value)
+    processPending();
+  ar(SUBCLASS(OwnedObject<PositionMatching>), matches, reverseMatches, targets);
 }
 
-SERIALIZE_DEF(PositionMatching, SUBCLASS(OwnedObject<PositionMatching>), matches, reverseMatches, targets)
+SERIALIZABLE(PositionMatching)
@@ -4,10 +4,13 @@
 #include "position.h"
 #include "position_map.h"
 
+/** Matches targets with distinct adjacent open squares, keeping the matching maximum. Updates are applied
+    lazily, so that many of them can be handled together in a few Hopcroft-Karp phases.*/
 class PositionMatching : public OwnedObject<PositionMatching> {
   public:
 
-  optional<Position> getMatch(Position) const;
+  /** Applies the pending updates first.*/
+  optional<Position> getMatch(Position);
   void releaseTarget(Position);
   void addTarget(Position);
   void updateMovement(Position);
@@ -16,11 +19,27 @@ class PositionMatching : public OwnedObject<PositionMatching> {
   void serialize(Archive&, const unsigned);
 
   private:
-  void findPath(Position);
-  bool findPath(Position, PositionSet& visited, bool matchedWithFather);
+  void processPending();
+  bool runPhase(const vector<Position>& sources, bool fromTargets);
+  vector<Position> getFreeTargetsReachableFrom(const vector<Position>& squares);
+  vector<Position> getNeighbors(Position, bool isTarget) const;
+  optional<Position> getPartner(Position, bool isTarget) const;
+  bool isSquare(Position) const;
+  bool hasNeighborTarget(Position) const;
+  optional<int> getLayer(Position) const;
+  void setLayer(Position, int);
+  void removeLayer(Position);
   PositionMap<Position> SERIAL(matches);
   PositionMap<Position> SERIAL(reverseMatches);
   PositionSet SERIAL(targets);
+  // Every augmenting path ends in one of these free targets or squares, so they are the only places
+  // that need to be searched from to make the matching maximum again.
+  vector<Position> pendingTargets;
+  vector<Position> pendingSquares;
+  // BFS layers of the current phase are stored as labelBase + layer. Older labels are below labelBase,
+  // so the map doesn't have to be cleared between phases.
+  PositionMap<int> labels;
+  int labelBase = 0;
   void setMatch(Position, Position);
   void removeMatch(Position);
 };
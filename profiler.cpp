@@ -0,0 +1,224 @@
+#include "stdafx.h"
+#include "util.h"
+#include "profiler.h"
+#include <iomanip>
+
+namespace Profiler {
+
+atomic<bool> enabled(false);
+
+static atomic<bool> overlayEnabled(false);
+
+static const long long startTicks = steady_clock::now().time_since_epoch().count();
+
+static long long getTicks() {
+  return steady_clock::now().time_since_epoch().count() - startTicks;
+}
+
+static double ticksToMicros(long long ticks) {
+  return double(ticks) * 1000000 * steady_clock::period::num / steady_clock::period::den;
+}
+
+namespace {
+struct Node {
+  const Site* site;
+  int parent;
+  vector<int> children;
+  long long time;
+  int count;
+};
+
+struct Event {
+  const Site* site;
+  long long start;
+  long long duration;
+};
+}
+
+struct ThreadData {
+  ThreadData(int index) : index(index), events(new Event[numEvents]), writePos(0) {
+    nodes.push_back(Node{nullptr, -1, {}, 0, 0});
+  }
+
+  int enter(const Site* site) {
+    for (int child : nodes[current].children)
+      if (nodes[child].site == site)
+        return current = child;
+    int index = nodes.size();
+    nodes.push_back(Node{site, current, {}, 0, 0});
+    nodes[current].children.push_back(index);
+    return current = index;
+  }
+
+  void leave(int node, long long start, long long duration) {
+    auto& elem = nodes[node];
+    elem.time += duration;
+    ++elem.count;
+    current = elem.parent;
+    auto pos = writePos.load(std::memory_order_relaxed);
+    events[pos % numEvents] = Event{elem.site, start, duration};
+    writePos.store(pos + 1, std::memory_order_release);
+  }
+
+  // Adds the subtree of the node in pre-order, leaving out nodes that weren't entered in this interval.
+  void addEntries(int node, int depth, vector<TreeEntry>& ret) const {
+    auto children = nodes[node].children;
+    std::stable_sort(children.begin(), children.end(),
+        [&](int a, int b) { return nodes[a].time > nodes[b].time; });
+    for (int child : children) {
+      auto& elem = nodes[child];
+      int entryIndex = ret.size();
+      ret.push_back(TreeEntry{elem.site->name, depth, ticksToMicros(elem.time) / 1000, elem.count});
+      addEntries(child, depth + 1, ret);
+      if (elem.count == 0 && ret.size() == entryIndex + 1)
+        ret.pop_back();
+    }
+  }
+
+  void clearCounters() {
+    for (auto& node : nodes) {
+      node.time = 0;
+      node.count = 0;
+    }
+  }
+
+  const int index;
+  vector<Node> nodes;
+  int current = 0;
+  static constexpr size_t numEvents = 1 << 16;
+  unique_ptr<Event[]> events;
+  atomic<size_t> writePos;
+  bool inUse = true;
+};
+
+constexpr size_t ThreadData::numEvents;
+
+static std::mutex& getMutex() {
+  static std::mutex ret;
+  return ret;
+}
+
+// Buffers of finished threads are handed to new threads instead of being freed, so that the trace can
+// still be written after the thread is gone, and so that short-lived workers don't allocate new buffers.
+static vector<unique_ptr<ThreadData>>& getAllThreads() {
+  static vector<unique_ptr<ThreadData>> ret;
+  return ret;
+}
+
+static array<vector<TreeEntry>, 2>& getLastTrees() {
+  static array<vector<TreeEntry>, 2> ret;
+  return ret;
+}
+
+namespace {
+struct ThreadHolder {
+  ~ThreadHolder() {
+    if (data) {
+      std::lock_guard<std::mutex> lock(getMutex());
+      data->inUse = false;
+    }
+  }
+  ThreadData* data = nullptr;
+};
+}
+
+static ThreadData* getThreadData() {
+  static thread_local ThreadHolder holder;
+  if (!holder.data) {
+    std::lock_guard<std::mutex> lock(getMutex());
+    auto& threads = getAllThreads();
+    for (auto& data : threads)
+      if (!data->inUse) {
+        data->inUse = true;
+        data->current = 0;
+        holder.data = data.get();
+        break;
+      }
+    if (!holder.data) {
+      threads.push_back(unique<ThreadData>(threads.size()));
+      holder.data = threads.back().get();
+    }
+  }
+  return holder.data;
+}
+
+void Scope::begin(const Site* site) {
+  threadData = getThreadData();
+  node = threadData->enter(site);
+  startTime = getTicks();
+}
+
+void Scope::end() {
+  threadData->leave(node, startTime, getTicks() - startTime);
+}
+
+void finishInterval(Interval interval) {
+  if (!enabled)
+    return;
+  auto data = getThreadData();
+  vector<TreeEntry> tree;
+  data->addEntries(0, 0, tree);
+  data->clearCounters();
+  std::lock_guard<std::mutex> lock(getMutex());
+  getLastTrees()[int(interval)] = std::move(tree);
+}
+
+vector<TreeEntry> getLastTree(Interval interval) {
+  std::lock_guard<std::mutex> lock(getMutex());
+  return getLastTrees()[int(interval)];
+}
+
+void setEnabled(bool value) {
+  enabled = value;
+}
+
+void setOverlayEnabled(bool value) {
+  overlayEnabled = value;
+}
+
+bool isOverlayEnabled() {
+  return overlayEnabled;
+}
+
+static string escapeJson(const char* s) {
+  string ret;
+  for (; *s; ++s) {
+    if (*s == '"' || *s == '\\')
+      ret += '\\';
+    ret += *s;
+  }
+  return ret;
+}
+
+void writeChromeTrace(const string& path) {
+  ofstream out(path);
+  out << std::fixed << std::setprecision(3) << "{\"traceEvents\":[";
+  bool first = true;
+  std::lock_guard<std::mutex> lock(getMutex());
+  for (auto& data : getAllThreads()) {
+    const auto numEvents = ThreadData::numEvents;
+    auto end = data->writePos.load(std::memory_order_acquire);
+    auto begin = end > numEvents ? end - numEvents : 0;
+    vector<Event> events;
+    for (auto i = begin; i < end; ++i)
+      events.push_back(data->events[i % numEvents]);
+    // The owning thread keeps recording while we copy. Drop the events that it may have overwritten,
+    // including the one it may be writing right now.
+    auto newEnd = data->writePos.load(std::memory_order_acquire);
+    auto firstValid = newEnd + 1 > numEvents ? newEnd + 1 - numEvents : 0;
+    for (int i : All(events))
+      if (begin + i >= firstValid) {
+        auto& event = events[i];
+        if (!first)
+          out << ",";
+        first = false;
+        out << "\n{\"name\":\"" << escapeJson(event.site->name) << "\",\"ph\":\"X\",\"pid\":0,\"tid\":"
+            << data->index << ",\"ts\":" << ticksToMicros(event.start) << ",\"dur\":"
+            << ticksToMicros(event.duration) << ",\"args\":{\"site\":\"" << escapeJson(event.site->file)
+            << ":" << event.site->line << "\"}}";
+      }
+  }
+  out << "\n]}\n";
+}
+
+}
@@ -1,5 +1,70 @@
 #pragma once
 
+#include "stdafx.h"
+#include "my_containers.h"
+
+/** Built-in profiler. Every PROFILE and PROFILE_BLOCK scope is timed while profiling is enabled. Each
+    thread aggregates its scopes into a call tree and records them in its own ring buffer, so recording
+    never takes a lock. The tree is handed over at the end of every frame and turn, and the ring buffers
+    can be written as a Chrome trace (chrome://tracing).*/
+namespace Profiler {
+
+struct Site {
+  const char* name;
+  const char* file;
+  int line;
+};
+
+extern atomic<bool> enabled;
+
+class Scope {
+  public:
+  Scope(const Site* site) {
+    if (enabled.load(std::memory_order_relaxed))
+      begin(site);
+  }
+
+  ~Scope() {
+    if (threadData)
+      end();
+  }
+
+  Scope(const Scope&) = delete;
+
+  private:
+  void begin(const Site*);
+  void end();
+  struct ThreadData* threadData = nullptr;
+  int node;
+  long long startTime;
+};
+
+enum class Interval {
+  FRAME,
+  TURN
+};
+
+struct TreeEntry {
+  string name;
+  int depth;
+  double millis;
+  int count;
+};
+
+/** Ends the current interval of the calling thread and makes its call tree available through getLastTree.
+    The children of every node are sorted by time, slowest first.*/
+void finishInterval(Interval);
+vector<TreeEntry> getLastTree(Interval);
+
+void setEnabled(bool);
+void setOverlayEnabled(bool);
+bool isOverlayEnabled();
+
+/** Writes all scopes that are still in the ring buffers in the Chrome trace event format.*/
+void writeChromeTrace(const string& path);
+
+}
+
 #ifdef EASY_PROFILER
 #define BUILD_WITH_EASY_PROFILER
 
@@ -15,8 +80,19 @@
 
 #else
 
-#define PROFILE
-#define PROFILE_BLOCK(...)
+#define PROFILE_CONCAT2(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT2(a, b)
+#define PROFILE_FIRST_ARG(name, ...) name
+
+// The name must be a string literal or __func__, as it's kept for the whole run. The trailing semicolon
+// lets PROFILE be written without one, like with easy_profiler.
+#define PROFILE_SCOPE(siteName)\
+  static const Profiler::Site PROFILE_CONCAT(profileSite, __LINE__) {siteName, __FILE__, __LINE__};\
+  Profiler::Scope PROFILE_CONCAT(profileScope, __LINE__)(&PROFILE_CONCAT(profileSite, __LINE__));
+
+#define PROFILE PROFILE_SCOPE(__func__)
+#define PROFILE_BLOCK(...) PROFILE_SCOPE(PROFILE_FIRST_ARG(__VA_ARGS__, 0))
+// The built-in profiler is only turned on by the --profile, --profile_trace and --profile_overlay flags.
 #define ENABLE_PROFILER
 
 #endif
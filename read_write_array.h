@@ -1,6 +1,7 @@
 #pragma once
 
 #include "util.h"
+#include "memory_report.h"
 
 template <typename Type, typename Param>
 class ReadWriteArray {
@@ -33,49 +34,122 @@ class ReadWriteArray {
       return nullptr;
   }
 
+  /** Returns the parameter the element at given position was generated from.*/
+  const optional<Param>& getParam(Vec2 pos) const {
+    return types[pos];
+  }
+
   template <typename Generator>
   void putElem(Vec2 pos, Param param, const Generator& generator) {
     if (!readonlyMap.count(param)) {
       allReadonly.push_back(generator(param));
-      CHECK(allReadonly.size() < 30000);
       readonlyMap.insert(make_pair(param, allReadonly.size() - 1));
     }
+    releaseModified(pos);
     readonly[pos] = readonlyMap.at(param);
-    modified[pos] = -1;
     types[pos] = param;
   }
 
   void putElem(Vec2 pos, PType s) {
-    allModified.push_back(std::move(s));
-    CHECK(allModified.size() < 30000);
-    modified[pos] = allModified.size() - 1;
+    releaseModified(pos);
+    int index = -1;
+    if (!freeSlots.empty()) {
+      index = freeSlots.back();
+      freeSlots.pop_back();
+      allModified[index] = std::move(s);
+    } else {
+      allModified.push_back(std::move(s));
+      index = allModified.size() - 1;
+    }
+    ++numModified;
+    modified[pos] = index;
     readonly[pos] = -1;
   }
 
   void clearElem(Vec2 pos) {
+    releaseModified(pos);
     types[pos] = none;
-    modified[pos] = -1;
     readonly[pos] = -1;
   }
 
+  /** Destroys elements that were removed or replaced since the last call and makes their slots available.
+      Must not be called while a pointer to any removed element may still be in use.*/
+  void reclaimReleased() {
+    for (int index : released) {
+      allModified[index].clear();
+      freeSlots.push_back(index);
+    }
+    released.clear();
+  }
+
   int getNumGenerated() const {
-    return allModified.size() + readonlyMap.size();
+    return numModified + readonlyMap.size();
   }
 
   int getNumTotal() const {
     return 0;
   }
 
-  SERIALIZE_ALL(modified, allModified, allReadonly, readonly, types, readonlyMap, numTotal)
+  template <class Archive>
+  void serialize(Archive& ar1, const unsigned int) {
+    if (Archive::is_saving::value)
+      compact();
+    ar1(modified, allModified, allReadonly, readonly, types, readonlyMap, numModified);
+  }
+
   SERIALIZATION_CONSTRUCTOR(ReadWriteArray)
 
+  void reportMemory(MemoryReport& report) const {
+    report.get("tables").add(modified.getMemoryBytes() + readonly.getMemoryBytes() + types.getMemoryBytes());
+    auto& modifiedReport = report.get("modified");
+    modifiedReport.addVector(allModified);
+    modifiedReport.add(numModified * sizeof(Type));
+    modifiedReport.addCount(numModified);
+    auto& readonlyReport = report.get("readonly");
+    readonlyReport.addVector(allReadonly);
+    readonlyReport.add(allReadonly.size() * sizeof(Type));
+    readonlyReport.addCount(allReadonly.size());
+    readonlyReport.addNodes(readonlyMap);
+  }
+
   private:
+  void releaseModified(Vec2 pos) {
+    if (modified[pos] > -1) {
+      // The element may still be executing (eg. furniture removing itself), so defer destroying it.
+      released.push_back(modified[pos]);
+      modified[pos] = -1;
+      --numModified;
+    }
+  }
+
+  void compact() {
+    reclaimReleased();
+    if (freeSlots.empty())
+      return;
+    vector<int> remap(allModified.size(), -1);
+    int cnt = 0;
+    for (int i : All(allModified))
+      if (allModified[i]) {
+        remap[i] = cnt;
+        if (i != cnt)
+          allModified[cnt] = std::move(allModified[i]);
+        ++cnt;
+      }
+    allModified.resize(cnt);
+    for (Vec2 v : modified.getBounds())
+      if (modified[v] > -1)
+        modified[v] = remap[modified[v]];
+    freeSlots.clear();
+  }
+
   vector<PType> SERIAL(allModified);
-  Table<short> SERIAL(modified);
+  Table<int> SERIAL(modified);
   vector<PType> SERIAL(allReadonly);
-  Table<short> SERIAL(readonly);
+  Table<int> SERIAL(readonly);
   Table<optional<Param>> SERIAL(types);
-  unordered_map<Param, short, CustomHash<Param>> SERIAL(readonlyMap);
-  int SERIAL(numTotal) = 0;
+  unordered_map<Param, int, CustomHash<Param>> SERIAL(readonlyMap);
+  int SERIAL(numModified) = 0;
+  vector<int> freeSlots;
+  vector<int> released;
 };
 
@@ -16,6 +16,7 @@
 #include "stdafx.h"
 #include "sectors.h"
 #include "level.h"
+#include "memory_report.h"
 #include <limits>
 
 Sectors::Sectors(Rectangle b, ExtraConnections con) : bounds(b), sectors(bounds, -1), extraConnections(std::move(con)) {
@@ -191,3 +192,8 @@ void Sectors::dump() {
   }
   std::cout << endl;
 }
+
+void Sectors::reportMemory(MemoryReport& report) const {
+  report.add(sectors.getMemoryBytes() + extraConnections.getMemoryBytes());
+  report.addVector(sizes);
+}
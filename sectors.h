@@ -17,6 +17,8 @@
 
 #include "util.h"
 
+class MemoryReport;
+
 class Sectors {
   public:
   using ExtraConnections = Table<optional<Vec2>>;
@@ -32,6 +34,7 @@ class Sectors {
   void addExtraConnection(Vec2, Vec2);
   void removeExtraConnection(Vec2, Vec2);
   const ExtraConnections getExtraConnections() const;
+  void reportMemory(MemoryReport&) const;
 
   private:
   using SectorId = short;
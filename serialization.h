@@ -141,3 +141,86 @@ void load(Archive& ar1, optional<T>& elem) {
     elem = none;
   }
 } // namespace cereal
+
+namespace serialization_impl {
+
+template <class Archive, typename T>
+void saveArray(Archive& ar, const T* elems, int size, std::false_type) {
+  for (int i = 0; i < size; ++i)
+    ar(elems[i]);
+}
+
+template <class Archive, typename T>
+void loadArray(Archive& ar, T* elems, int size, std::false_type) {
+  for (int i = 0; i < size; ++i)
+    ar(elems[i]);
+}
+
+template <class Archive, typename T>
+void saveArray(Archive& ar, const T* elems, int size, std::true_type) {
+  auto sameAsPrevious = [&](int i) { return i > 0 && memcmp(&elems[i], &elems[i - 1], sizeof(T)) == 0; };
+  int numRuns = 0;
+  for (int i = 0; i < size; ++i)
+    if (!sameAsPrevious(i))
+      ++numRuns;
+  bool useRuns = 2 * numRuns * (sizeof(T) + sizeof(int)) < size * sizeof(T);
+  ar(useRuns);
+  if (useRuns) {
+    std::vector<int> lengths;
+    std::vector<char> values(numRuns * sizeof(T));
+    lengths.reserve(numRuns);
+    for (int i = 0; i < size; ++i)
+      if (sameAsPrevious(i))
+        ++lengths.back();
+      else {
+        memcpy(&values[lengths.size() * sizeof(T)], &elems[i], sizeof(T));
+        lengths.push_back(1);
+      }
+    ar(numRuns);
+    ar(cereal::binary_data(lengths.data(), numRuns * sizeof(int)));
+    ar(cereal::binary_data(values.data(), numRuns * sizeof(T)));
+  } else
+    ar(cereal::binary_data(static_cast<const T*>(elems), size * sizeof(T)));
+}
+
+template <class Archive, typename T>
+void loadArray(Archive& ar, T* elems, int size, std::true_type) {
+  bool useRuns;
+  ar(useRuns);
+  if (useRuns) {
+    int numRuns;
+    ar(numRuns);
+    if (numRuns < 0 || numRuns > size)
+      throw cereal::Exception("Bad number of runs in array");
+    std::vector<int> lengths(numRuns);
+    std::vector<char> values(numRuns * sizeof(T));
+    ar(cereal::binary_data(lengths.data(), numRuns * sizeof(int)));
+    ar(cereal::binary_data(values.data(), numRuns * sizeof(T)));
+    int pos = 0;
+    for (int run = 0; run < numRuns; ++run) {
+      if (lengths[run] < 0 || pos + lengths[run] > size)
+        throw cereal::Exception("Array runs exceed the array size");
+      for (int i = 0; i < lengths[run]; ++i)
+        memcpy(&elems[pos++], &values[run * sizeof(T)], sizeof(T));
+    }
+    if (pos != size)
+      throw cereal::Exception("Array runs don't cover the array");
+  } else
+    ar(cereal::binary_data(static_cast<T*>(elems), size * sizeof(T)));
+}
+
+}
+
+/** Serializes a contiguous array. Trivially copyable elements are written as raw memory instead of one by one,
+    or as runs of equal elements if there are few of them, eg. in mostly uniform grids.*/
+template <class Archive, typename T>
+void saveArray(Archive& ar, const T* elems, int size) {
+  serialization_impl::saveArray(ar, elems, size, std::integral_constant<bool, std::is_trivially_copyable<T>::value &&
+      cereal::traits::is_output_serializable<cereal::BinaryData<const T*>, Archive>::value>());
+}
+
+template <class Archive, typename T>
+void loadArray(Archive& ar, T* elems, int size) {
+  serialization_impl::loadArray(ar, elems, size, std::integral_constant<bool, std::is_trivially_copyable<T>::value &&
+      cereal::traits::is_input_serializable<cereal::BinaryData<T*>, Archive>::value>());
+}
@@ -121,11 +121,20 @@ bool Spell::checkTrajectory(const Creature* c, Position to) const {
 }
 
 MoveInfo Spell::getAIMove(const Creature* c) const {
-  if (c->isReady(this))
-    for (auto pos : c->getPosition().getRectangle(Rectangle::centered(range)))
+  if (c->isReady(this)) {
+    // Most spells can only be wanted on a visible creature, so the trajectories to empty squares aren't checked.
+    bool needsVictim = effect->needsAIVictim();
+    for (auto pos : c->getPosition().getRectangle(Rectangle::centered(range))) {
+      if (needsVictim) {
+        auto victim = pos.getCreature();
+        if (!victim || !c->canSee(victim))
+          continue;
+      }
       if ((pos == c->getPosition() && canTargetSelf()) || (c->canSee(pos) && pos != c->getPosition() && checkTrajectory(c, pos)))
         if (effect->shouldAIApply(c, pos) == EffectAIIntent::WANTED)
           return c->castSpell(this, pos);
+    }
+  }
   return NoMove;
 }
 
@@ -2,27 +2,71 @@
 #include "territory.h"
 #include "position.h"
 #include "movement_type.h"
-#include "position_map.h"
+#include "level.h"
 
-SERIALIZE_DEF(Territory, allSquares, allSquaresVec, centralPoint)
+template <class Archive>
+void Territory::serialize(Archive& ar, const unsigned int) {
+  ar(allSquares, allSquaresVec, centralPoint);
+  if (Archive::is_loading::value)
+    for (int i : All(allSquaresVec))
+      squareIndexes[allSquaresVec[i]] = i;
+}
 
-void Territory::clearCache() {
-  extendedCache.clear();
-  extendedCache2.clear();
+SERIALIZABLE(Territory)
+
+static bool canExtendTo(Position pos) {
+  return pos.canEnterEmpty({MovementTrait::WALK});
 }
 
 void Territory::insert(Position pos) {
   if (!allSquares.count(pos)) {
+    squareIndexes[pos] = allSquaresVec.size();
     allSquaresVec.push_back(pos);
     allSquares.insert(pos);
-    clearCache();
+    epoch.bump();
+    if (maxDistance > 0) {
+      distances[pos] = 1;
+      spreadDistances({pos});
+      extendedCache.clear();
+    }
   }
 }
 
 void Territory::remove(Position pos) {
-  allSquaresVec.removeElement(pos);
-  allSquares.erase(pos);
-  clearCache();
+  if (auto index = getValueMaybe(squareIndexes, pos)) {
+    allSquaresVec.removeIndex(*index);
+    if (*index < allSquaresVec.size())
+      squareIndexes[allSquaresVec[*index]] = *index;
+    squareIndexes.erase(pos);
+    allSquares.erase(pos);
+    epoch.bump();
+    if (maxDistance > 0) {
+      recalculateDistancesAround(pos);
+      extendedCache.clear();
+    }
+  }
+}
+
+void Territory::updateMovement(Position pos) {
+  if (maxDistance == 0 || contains(pos))
+    return;
+  bool wasReachable = distances.count(pos);
+  if (wasReachable == canExtendTo(pos))
+    return;
+  if (wasReachable)
+    recalculateDistancesAround(pos);
+  else {
+    optional<int> closest;
+    for (auto v : pos.neighbors8())
+      if (auto dist = getValueMaybe(distances, v))
+        if (!closest || *dist < *closest)
+          closest = *dist;
+    if (!closest || *closest + 1 >= maxDistance)
+      return;
+    distances[pos] = *closest + 1;
+    spreadDistances({pos});
+  }
+  extendedCache.clear();
 }
 
 void Territory::setCentralPoint(Position pos) {
@@ -41,29 +85,62 @@ const PositionSet& Territory::getAllAsSet() const {
   return allSquares;
 }
 
-vector<Position> Territory::calculateExtended(int minRadius, int maxRadius) const {
-  PROFILE;
-  PositionMap<int> extendedTiles;
-  vector<Position> extendedQueue;
-  for (Position pos : allSquaresVec) {
-    if (!extendedTiles.contains(pos))  {
-      extendedTiles.set(pos, 1);
-      extendedQueue.push_back(pos);
-    }
-  }
-  for (int i = 0; i < extendedQueue.size(); ++i) {
-    Position pos = extendedQueue[i];
-    auto value = extendedTiles.getOrFail(pos);
+// Lowers the distances of the neighbors of the queued squares for as long as they improve. The squares with
+// the smallest distances should come first, otherwise some squares are visited more than once.
+void Territory::spreadDistances(vector<Position> queue) const {
+  for (int i = 0; i < queue.size(); ++i) {
+    Position pos = queue[i];
+    int next = distances.at(pos) + 1;
+    if (next >= maxDistance)
+      continue;
     for (Position v : pos.neighbors8())
-      if (!contains(v) && !extendedTiles.contains(v) && v.canEnterEmpty({MovementTrait::WALK})) {
-        extendedTiles.set(v, value + 1);
-        if (value + 1 < maxRadius)
-          extendedQueue.push_back(v);
+      if (!contains(v)) {
+        auto it = distances.find(v);
+        if (it != distances.end() ? it->second > next : canExtendTo(v)) {
+          distances[v] = next;
+          queue.push_back(v);
+        }
+      }
+  }
+}
+
+void Territory::calculateDistances(int maxDist) const {
+  PROFILE;
+  maxDistance = maxDist;
+  distances.clear();
+  extendedCache.clear();
+  for (Position pos : allSquaresVec)
+    distances[pos] = 1;
+  spreadDistances(allSquaresVec);
+}
+
+void Territory::updateDistances(int maxDist) const {
+  if (maxDist > maxDistance)
+    calculateDistances(maxDist);
+}
+
+// A change at a square can only affect squares closer to it than maxDistance, so only those are recalculated,
+// starting from the territory among them and from the unaffected squares around them.
+void Territory::recalculateDistancesAround(Position center) const {
+  PROFILE;
+  auto level = center.getLevel();
+  auto area = Rectangle::centered(center.getCoord(), maxDistance);
+  for (Vec2 v : area)
+    distances.erase(Position(v, level));
+  vector<pair<int, Position>> sources;
+  for (Vec2 v : Rectangle::centered(center.getCoord(), maxDistance + 1)) {
+    Position pos(v, level);
+    if (v.inRectangle(area)) {
+      if (contains(pos)) {
+        distances[pos] = 1;
+        sources.push_back({1, pos});
       }
+    } else if (auto dist = getValueMaybe(distances, pos))
+      sources.push_back({*dist, pos});
   }
-  if (minRadius > 0)
-    return extendedQueue.filter([&] (const Position& v) { return extendedTiles.getOrFail(v) >= minRadius; });
-  return extendedQueue;
+  std::stable_sort(sources.begin(), sources.end(),
+      [](const pair<int, Position>& a, const pair<int, Position>& b) { return a.first < b.first; });
+  spreadDistances(sources.transform([](const pair<int, Position>& elem) { return elem.second; }));
 }
 
 const vector<Position>& Territory::getStandardExtended() const {
@@ -71,22 +148,48 @@ const vector<Position>& Territory::getStandardExtended() const {
 }
 
 const vector<Position>& Territory::getExtended(int min, int max) const {
-  if (!extendedCache.count(make_pair(min, max)))
-    extendedCache[make_pair(min, max)] = calculateExtended(min, max);
-  return extendedCache.at(make_pair(min, max));
+  auto key = make_pair(min, max);
+  if (!extendedCache.count(key)) {
+    updateDistances(max);
+    vector<pair<int, Position>> found;
+    for (auto& elem : distances)
+      if (elem.second >= min && elem.second < max)
+        found.push_back({elem.second, elem.first});
+    // The hash map's order depends on its history, so sort the squares to keep the game deterministic.
+    auto getKey = [](const pair<int, Position>& elem) {
+      return make_tuple(elem.first, elem.second.getLevel()->getUniqueId(), elem.second.getCoord().x,
+          elem.second.getCoord().y);
+    };
+    std::sort(found.begin(), found.end(),
+        [&](const pair<int, Position>& a, const pair<int, Position>& b) { return getKey(a) < getKey(b); });
+    extendedCache[key] = found.transform([](const pair<int, Position>& elem) { return elem.second; });
+  }
+  return extendedCache.at(key);
 }
 
 const vector<Position>& Territory::getExtended(int max) const {
-  if (!extendedCache2.count(max))
-    extendedCache2[max] = calculateExtended(0, max);
-  return extendedCache2.at(max);
+  return getExtended(0, max);
+}
+
+bool Territory::isInExtended(Position pos, int min, int max) const {
+  updateDistances(max);
+  if (auto dist = getValueMaybe(distances, pos))
+    return *dist >= min && *dist < max;
+  return false;
+}
+
+bool Territory::isInStandardExtended(Position pos) const {
+  return isInExtended(pos, 2, 10);
 }
 
 bool Territory::isEmpty() const {
   return allSquaresVec.empty();
 }
 
+long long Territory::getEpoch() const {
+  return epoch.get();
+}
+
 const optional<Position>& Territory::getCentralPoint() const {
   return centralPoint;
 }
-
@@ -2,33 +2,48 @@
 
 #include "util.h"
 #include "position.h"
+#include "memo.h"
 
 class Territory {
   public:
   void insert(Position);
   void remove(Position);
   void setCentralPoint(Position);
+  /** Must be called when the square may have become walkable or unwalkable.*/
+  void updateMovement(Position);
 
   bool contains(Position) const;
   const vector<Position>& getAll() const;
   const PositionSet& getAllAsSet() const;
+  /** Returns squares whose distance is at least min and less than max. The territory squares have distance 1,
+      and the distance grows by 1 with every walkable square outside the territory.*/
   const vector<Position>& getExtended(int min, int max) const;
   const vector<Position>& getExtended(int max) const;
   const vector<Position>& getStandardExtended() const;
+  bool isInExtended(Position, int min, int max) const;
+  bool isInStandardExtended(Position) const;
   bool isEmpty() const;
+  /** Changes whenever a square is inserted or removed.*/
+  long long getEpoch() const;
   const optional<Position>& getCentralPoint() const;
 
   template <class Archive>
   void serialize(Archive& ar, const unsigned int version);
 
   private:
-  void clearCache();
-  vector<Position> calculateExtended(int minRadius, int maxRadius) const;
+  void calculateDistances(int maxDistance) const;
+  void updateDistances(int maxDistance) const;
+  void recalculateDistancesAround(Position) const;
+  void spreadDistances(vector<Position> queue) const;
   PositionSet SERIAL(allSquares);
   vector<Position> SERIAL(allSquaresVec);
   optional<Position> SERIAL(centralPoint);
+  unordered_map<Position, int, CustomHash<Position>> squareIndexes;
+  // Distances of all squares closer than maxDistance, kept up to date when the territory or the walkability
+  // of squares changes. Built on the first query, so it's not serialized.
+  mutable unordered_map<Position, int, CustomHash<Position>> distances;
+  mutable int maxDistance = 0;
   mutable map<pair<int, int>, vector<Position>> extendedCache;
-  mutable map<int, vector<Position>> extendedCache2;
+  DirtyEpoch epoch;
 };
 
-
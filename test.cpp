@@ -28,6 +28,7 @@
 #include "item.h"
 #include "attr_type.h"
 #include "body.h"
+#include "equipment.h"
 #include "call_cache.h"
 #include "container_range.h"
 #include "serialization.h"
@@ -46,6 +47,19 @@
 #include "test_struct.h"
 #include "biome_id.h"
 #include "item_types.h"
+#include "read_write_array.h"
+#include "tiled_table.h"
+#include "memo.h"
+#include "memory_report.h"
+#include "creature_attributes.h"
+#include "territory.h"
+#include "furniture.h"
+#include "inventory.h"
+#include "object_pool.h"
+#include "async_log.h"
+#include "controller.h"
+#include "time_queue.h"
+#include "main_loop.h"
 
 class Test {
   public:
@@ -78,6 +92,128 @@ class Test {
     CHECK(q.getNextCreature() == ra);*/
   }
 
+  // Runs random operations on a TimeQueue and checks it against a plain ordering of the creatures by time,
+  // extra move, players first and the order of their last rescheduling.
+  void testTimeQueueRandom() {
+    auto contentFactory = getContentFactory();
+    struct PlayerController : public DoNothingController {
+      using DoNothingController::DoNothingController;
+      virtual bool isPlayer() const override {
+        return true;
+      }
+    };
+    struct Schedule {
+      long long key;
+      bool player;
+      long long order;
+    };
+    RandomGen random;
+    random.init(1);
+    TimeQueue queue;
+    unordered_map<Creature*, Schedule> schedules;
+    vector<Creature*> all;
+    long long backOrder = 0;
+    long long frontOrder = 0;
+    int time = 0;
+    auto before = [&] (Creature* c1, Creature* c2) {
+      auto& s1 = schedules.at(c1);
+      auto& s2 = schedules.at(c2);
+      return std::make_tuple(s1.key, !s1.player, s1.order) < std::make_tuple(s2.key, !s2.player, s2.order);
+    };
+    auto getFirst = [&] (function<bool(Creature*)> pred) {
+      Creature* ret = nullptr;
+      for (auto c : all)
+        if (pred(c) && (!ret || before(c, ret)))
+          ret = c;
+      return ret;
+    };
+    auto getNext = [&] () -> Creature* {
+      auto first = getFirst([] (Creature*) { return true; });
+      if (!first)
+        return nullptr;
+      auto key = schedules.at(first).key;
+      if ((double) (key >> 1) + ((key & 1) ? 0.5 : 0) > time)
+        return nullptr;
+      // Players with an extra move go before the regular moves of everyone else.
+      if (!(key & 1))
+        if (auto player = getFirst([&] (Creature* c) { return schedules.at(c).key == key + 1 && schedules.at(c).player; }))
+          return player;
+      return first;
+    };
+    auto reschedule = [&] (Creature* c, long long key, bool atFront) {
+      schedules.at(c).key = key;
+      schedules.at(c).order = atFront ? --frontOrder : backOrder++;
+    };
+    auto getInterval = [&] {
+      // Long intervals put the creature past the buckets that are kept near the current time.
+      return random.roll(15) ? 600 + random.get(1500) : 1 + random.get(3);
+    };
+    auto add = [&] {
+      auto c = contentFactory.getCreatures().fromId(CreatureId("KNIGHT"), TribeId::getMonster());
+      bool player = random.roll(4);
+      if (player)
+        c->controllerStack.push_back(makeOwner<PlayerController>(c.get()));
+      int t = time + (random.roll(20) ? getInterval() : random.get(3));
+      all.push_back(c.get());
+      schedules[c.get()] = Schedule{2 * (long long) t, player, backOrder++};
+      queue.addCreature(std::move(c), LocalTime(t));
+    };
+    for (int step : Range(5000)) {
+      if (all.size() < 5 || random.roll(20))
+        add();
+      auto next = queue.getNextCreature(time);
+      CHECK(next == getNext()) << "Step " << step;
+      if (!next) {
+        time += random.roll(10) ? 1500 : 1;
+        continue;
+      }
+      vector<Creature*> movingNow;
+      auto minKey = schedules.at(getFirst([] (Creature*) { return true; })).key;
+      for (auto c : all)
+        if (schedules.at(c).key == minKey)
+          movingNow.push_back(c);
+      std::sort(movingNow.begin(), movingNow.end(), before);
+      CHECK(queue.getCreaturesMovingNow() == movingNow) << "Step " << step;
+      for (auto c : all) {
+        auto key = schedules.at(c).key;
+        CHECK(queue.getTime(c).getInternal() == key >> 1);
+        CHECK(queue.hasExtraMove(c) == (key & 1));
+        CHECK(queue.willMoveThisTurn(c) == ((key >> 1) == (minKey >> 1) && (!(key & 1) || (minKey & 1))));
+      }
+      for (auto c1 : movingNow)
+        for (auto c2 : movingNow)
+          CHECK(queue.compareOrder(c1, c2) == before(c1, c2)) << "Step " << step;
+      if (random.roll(4) && !queue.hasExtraMove(next)) {
+        queue.makeExtraMove(next);
+        reschedule(next, schedules.at(next).key + 1, false);
+      } else {
+        auto interval = getInterval();
+        queue.increaseTime(next, TimeInterval(interval));
+        reschedule(next, 2 * ((schedules.at(next).key >> 1) + interval), false);
+      }
+      auto other = random.choose(all);
+      switch (random.get(5)) {
+        case 0:
+          queue.moveNow(other);
+          reschedule(other, schedules.at(other).key, true);
+          break;
+        case 1:
+          queue.postponeMove(other);
+          reschedule(other, schedules.at(other).key, false);
+          break;
+        case 2:
+          if (all.size() > 5) {
+            queue.removeCreature(other);
+            schedules.erase(other);
+            all.removeElement(other);
+          }
+          break;
+        default:
+          break;
+      }
+    }
+  }
+
   void testRectangleIterator() {
     vector<Vec2> v1, v2;
     for (Vec2 v : Rectangle(10, 10)) {
@@ -589,6 +725,109 @@ class Test {
     CHECKEQ(numRef, 0);
   }
 
+  void testReadWriteArraySlotReuse() {
+    static int numRef = 0;
+    numRef = 0;
+    struct tmp : public OwnedObject<tmp> {
+      tmp(int a) : x(a) { ++numRef;}
+      tmp(const tmp& o) : x(o.x) { ++numRef;}
+      ~tmp() { --numRef; }
+      int x;
+    };
+    ReadWriteArray<tmp, int> array(Rectangle(10, 10));
+    for (Vec2 v : Rectangle(10, 10))
+      array.putElem(v, v.x, [](int x) { return makeOwner<tmp>(x); });
+    CHECKEQ(numRef, 10);
+    for (int i : Range(5))
+      for (Vec2 v : Rectangle(10, 10))
+        array.putElem(v, makeOwner<tmp>(i));
+    CHECKEQ(numRef, 510);
+    array.reclaimReleased();
+    CHECKEQ(numRef, 110);
+    array.clearElem(Vec2(3, 3));
+    CHECK(!array.getReadonly(Vec2(3, 3)));
+    CHECKEQ(array.getReadonly(Vec2(4, 4))->x, 4);
+    array.reclaimReleased();
+    CHECKEQ(numRef, 109);
+    CHECKEQ(array.getWritable(Vec2(5, 5))->x, 4);
+  }
+
+  void testBitTable() {
+    Rectangle bounds(-3, 2, 67, 43);
+    Table<bool> t(bounds, false);
+    Table<int> ref(bounds, 0);
+    for (int i : Range(500)) {
+      Vec2 v = bounds.randomVec2();
+      bool value = Random.roll(3);
+      t[v] = value;
+      ref[v] = value;
+    }
+    for (Vec2 v : bounds)
+      CHECKEQ(t[v], ref[v] == 1);
+    // Rectangles of full height take the single range path, the others go column by column.
+    for (int i : Range(100)) {
+      Rectangle r = Random.roll(4) ? Rectangle(Random.get(-5, 60), bounds.top(), Random.get(60, 70), bounds.bottom())
+          : Rectangle::centered(bounds.randomVec2(), Random.get(5, 20));
+      bool value = Random.roll(2);
+      t.fill(r, value);
+      for (Vec2 v : r.intersection(bounds))
+        ref[v] = value;
+    }
+    for (Vec2 v : bounds)
+      CHECKEQ(t[v], ref[v] == 1);
+    Table<bool> full(bounds, true);
+    for (Vec2 v : bounds)
+      CHECK(full[v]);
+    bool prev = t[Vec2(10, 10)];
+    t[Vec2(10, 10)] = !prev;
+    CHECK(t[Vec2(10, 10)] != prev);
+  }
+
+  void testTiledTable() {
+    Rectangle bounds(-5, 3, 30, 20);
+    Table<int> table(bounds);
+    for (Vec2 v : bounds)
+      table[v] = v.x * 100 + v.y;
+    TiledTable<int> tiled(table);
+    for (Vec2 v : bounds)
+      CHECKEQ(tiled[v], table[v]);
+    tiled[Vec2(29, 19)] = -1;
+    CHECKEQ(tiled[Vec2(29, 19)], -1);
+    CHECKEQ(tiled[Vec2(28, 19)], table[Vec2(28, 19)]);
+  }
+
+  void testTableSerialization() {
+    Rectangle bounds(-2, 1, 40, 35);
+    Table<int> uniform(bounds, -1);
+    uniform[Vec2(5, 5)] = 3;
+    Table<double> noise(bounds);
+    for (Vec2 v : bounds)
+      noise[v] = Random.getDouble();
+    Table<bool> bits(bounds, false);
+    bits.fill(Rectangle(0, 3, 20, 30), true);
+    Table<string> names(bounds, "abc");
+    TiledTable<double> tiled(noise);
+    stringstream ss;
+    {
+      OutputArchive output(ss);
+      output(uniform, noise, bits, names, tiled);
+    }
+    Table<int> uniform2;
+    Table<double> noise2;
+    Table<bool> bits2;
+    Table<string> names2;
+    TiledTable<double> tiled2;
+    InputArchive input(ss);
+    input(uniform2, noise2, bits2, names2, tiled2);
+    for (Vec2 v : bounds) {
+      CHECKEQ(uniform2[v], uniform[v]);
+      CHECKEQ(noise2[v], noise[v]);
+      CHECKEQ(bits2[v], bits[v]);
+      CHECKEQ(names2[v], names[v]);
+      CHECKEQ(tiled2[v], tiled[v]);
+    }
+  }
+
   static ContentFactory getContentFactory() {
     GameConfig config(DirectoryPath("data_free/game_config/"), "vanilla");
     ContentFactory contentFactory;
@@ -596,6 +835,21 @@ class Test {
     return contentFactory;
   }
 
+  // Serial battle tests run each battle on a copy of the parsed content.
+  void testContentFactoryCopy() {
+    FurnitureType type("MOUNTAIN");
+    unique_ptr<ContentFactory> copy;
+    {
+      auto contentFactory = getContentFactory();
+      copy.reset(new ContentFactory(contentFactory));
+      CHECK(&copy->furniture.getData(type) != &contentFactory.furniture.getData(type));
+      CHECKEQ(copy->getCreatures().getAllCreatures().size(), contentFactory.getCreatures().getAllCreatures().size());
+    }
+    CHECK(copy->furniture.getData(type).getType() == type);
+    auto creature = copy->getCreatures().fromId(CreatureId("KNIGHT"), TribeId::getMonster());
+    CHECK(!!creature);
+  }
+
   void testMinionEquipment1() {
     auto contentFactory = getContentFactory();
     PItem bow1 = ItemType(CustomItemId("Bow")).get(&contentFactory);
@@ -891,6 +1145,201 @@ class Test {
     CHECKEQ(cache.getSize(), 3);
   }
 
+  void testCacheStamped() {
+    TestCache cache(10);
+    int value = 15;
+    auto gen = [&] { return genString1(value); };
+    CHECKEQ(cache.getStamped(gen, 123, 1), "15");
+    value = 16;
+    CHECKEQ(cache.getStamped(gen, 123, 1), "15");
+    CHECKEQ(cnt1, 1);
+    CHECKEQ(cache.getStamped(gen, 123, 2), "16");
+    CHECKEQ(cache.getStamped(gen, 124, 2), "16");
+    CHECKEQ(cnt1, 3);
+  }
+
+  void testMemo() {
+    MemoStats stats("Test::testMemo");
+    Memo<int, string> memo;
+    CHECKEQ(memo.get(1, stats, [this] { return genString1(1); }), "1");
+    CHECKEQ(memo.get(1, stats, [this] { return genString1(1); }), "1");
+    CHECKEQ(cnt1, 1);
+    CHECKEQ(memo.get(2, stats, [this] { return genString1(2); }), "2");
+    CHECKEQ(cnt1, 2);
+    DirtyEpoch epoch;
+    DirtyEpoch copy(epoch);
+    auto value = epoch.get();
+    CHECK(copy.get() != value);
+    epoch.bump();
+    CHECK(epoch.get() != value);
+  }
+
+  void testCreatureAttrMemo() {
+    PCreature human = CreatureFactory::getHumanForTests();
+    int damage = human->getAttr(AttrType::DAMAGE);
+    CHECKEQ(human->getAttr(AttrType::DAMAGE), damage);
+    human->getAttributes().increaseBaseAttr(AttrType::DAMAGE, 5);
+    CHECKEQ(human->getAttr(AttrType::DAMAGE), damage + 5);
+    CHECK(human->getBestAttack().value >= damage + 5);
+    int defense = human->getAttr(AttrType::DEFENSE);
+    human->getAttributes().addPermanentEffect(LastingEffect::DEF_BONUS, 1);
+    CHECK(human->getAttr(AttrType::DEFENSE) > defense);
+    human->getAttributes().removePermanentEffect(LastingEffect::DEF_BONUS, 1);
+    CHECKEQ(human->getAttr(AttrType::DEFENSE), defense);
+  }
+
+  void testCreatureAttrMemoEquipment() {
+    auto contentFactory = getContentFactory();
+    PCreature human = CreatureFactory::getHumanForTests();
+    PItem sword = ItemType(CustomItemId("Sword")).get(&contentFactory);
+    Item* swordRef = sword.get();
+    auto attr = swordRef->getWeaponInfo().meleeAttackAttr;
+    auto& equipment = human->getEquipment();
+    int base = human->getAttr(attr);
+    equipment.addItem(std::move(sword), human.get());
+    equipment.equip(swordRef, EquipmentSlot::WEAPON, human.get());
+    int value = human->getAttr(attr);
+    int attack = human->getBestAttack().value;
+    equipment.addModifier(swordRef, attr, 3);
+    CHECKEQ(human->getAttr(attr), value + 3);
+    CHECK(human->getBestAttack().value > attack);
+    equipment.unequip(swordRef, human.get());
+    CHECKEQ(human->getAttr(attr), base);
+  }
+
+  void testProfiler() {
+    static const Profiler::Site outerSite {"outer", __FILE__, __LINE__};
+    static const Profiler::Site innerSite {"inner", __FILE__, __LINE__};
+    Profiler::setEnabled(true);
+    Profiler::finishInterval(Profiler::Interval::TURN);
+    for (int i : Range(3)) {
+      Profiler::Scope outer(&outerSite);
+      for (int j : Range(2)) {
+        Profiler::Scope inner(&innerSite);
+      }
+    }
+    Profiler::finishInterval(Profiler::Interval::TURN);
+    Profiler::setEnabled(false);
+    auto tree = Profiler::getLastTree(Profiler::Interval::TURN);
+    CHECKEQ(tree.size(), 2);
+    CHECKEQ(tree[0].name, "outer");
+    CHECKEQ(tree[0].depth, 0);
+    CHECKEQ(tree[0].count, 3);
+    CHECKEQ(tree[1].name, "inner");
+    CHECKEQ(tree[1].depth, 1);
+    CHECKEQ(tree[1].count, 6);
+  }
+
+  void testMemoryReport() {
+    MemoryReport report("root");
+    report.add(10);
+    report.get("a").add(100, 200);
+    report.get("a").get("b").add(5);
+    report.get("a").addCount(2);
+    vector<int> v;
+    v.reserve(10);
+    v.push_back(1);
+    report.get("c").addVector(v);
+    CHECKEQ(report.get("a").getLiveBytes(), 105);
+    CHECKEQ(report.get("a").getReservedBytes(), 205);
+    CHECKEQ(report.getLiveBytes(), 115 + sizeof(int));
+    CHECKEQ(report.getReservedBytes(), 215 + v.capacity() * sizeof(int));
+    stringstream ss;
+    report.print(ss, 100);
+    CHECK(contains(ss.str(), "a: "));
+    CHECK(!contains(ss.str(), "b: "));
+  }
+
+  void testWorkerPool() {
+    WorkerPool workers(3);
+    for (int num : {0, 1, 100, 1000}) {
+      vector<int> calls(num, 0);
+      workers.run(num, [&] (int i) { ++calls[i]; });
+      for (int i : Range(num))
+        CHECKEQ(calls[i], 1);
+    }
+  }
+
+  void testObjectPool() {
+    using Elem = pair<int, double>;
+    PoolAllocator<Elem> allocator("test pool");
+    auto p1 = allocator.allocate(1);
+    auto p2 = allocator.allocate(1);
+    CHECK(p1 != p2);
+    allocator.deallocate(p1, 1);
+    CHECK(allocator.allocate(1) == p1);
+    auto shared = std::allocate_shared<Elem>(allocator, 5, 2.0);
+    CHECKEQ(shared->first, 5);
+    MemoryReport report("pools");
+    ObjectPool::reportMemory(report);
+    stringstream ss;
+    report.print(ss);
+    CHECK(contains(ss.str(), "test pool: ")) << ss.str();
+    CHECK(contains(ss.str(), "3 objects")) << ss.str();
+    // Types of the same size class share a pool.
+    PoolAllocator<pair<double, int>> other(allocator);
+    allocator.deallocate(p2, 1);
+    CHECK((void*) other.allocate(1) == (void*) p2);
+    allocator.deallocate(p1, 1);
+    allocator.deallocate(p2, 1);
+    shared.reset();
+    MemoryReport report2("pools");
+    ObjectPool::reportMemory(report2);
+    CHECKEQ(report2.get("test pool").getLiveBytes(), 0);
+    CHECK(report2.get("test pool").getReservedBytes() > 0);
+  }
+
+  // The workers log more lines than fit in the ring buffer and flush, like a crashing battle does.
+  void testAsyncLogWorkers() {
+    const char* path = "test_async_log.bin.gz";
+    {
+      AsyncLog asyncLog(path);
+      DebugLog log;
+      log.addOutput(asyncLog.getOutput());
+      log.get() << "before workers";
+      RandomGen random;
+      random.init(0);
+      vector<optional<int>> results;
+      MainLoop::runInWorkers(4, 2, random,
+          [&] (bool inWorker) {
+            for (int i : Range(20000))
+              log.get() << "worker line " << i;
+            asyncLog.flush();
+            return inWorker ? 1 : 0;
+          },
+          [&] (optional<int> result) { results.push_back(result); });
+      log.get() << "after workers";
+      asyncLog.flush();
+      CHECKEQ(results.size(), 4);
+#ifndef WINDOWS
+      for (auto& result : results)
+        CHECK(result == 1);
+#endif
+    }
+    stringstream ss;
+    AsyncLog::decode(path, ss);
+    std::remove(path);
+    CHECK(contains(ss.str(), "before workers"));
+    CHECK(contains(ss.str(), "after workers"));
+#ifndef WINDOWS
+    CHECK(!contains(ss.str(), "worker line"));
+#endif
+  }
+
+  void testInventoryChangeEpoch() {
+    auto contentFactory = getContentFactory();
+    Inventory inventory;
+    auto epoch = Inventory::getChangeEpoch();
+    inventory.addItem(ItemType(CustomItemId("Sword")).get(&contentFactory));
+    CHECK(Inventory::getChangeEpoch() != epoch);
+    CHECKEQ(inventory.getItems(ItemIndex::WEAPON).size(), 1);
+    epoch = Inventory::getChangeEpoch();
+    CHECKEQ(inventory.getItems(ItemIndex::WEAPON).size(), 1);
+    CHECKEQ(Inventory::getChangeEpoch(), epoch);
+    inventory.removeItem(inventory.getItems()[0]);
+    CHECK(Inventory::getChangeEpoch() != epoch);
+  }
+
   struct Tmp123 {
     int SERIAL(a);
     char SERIAL(a1);
@@ -1037,10 +1486,10 @@ class Test {
   }
 
   struct MatchingTest {
-    MatchingTest() {
+    MatchingTest(int size = 10) {
       auto contentFactory = getContentFactory();
       auto model = Model::create(&contentFactory, BiomeId::GRASSLAND);
-      LevelBuilder builder(nullptr, Random, &contentFactory, 10, 10, false, none);
+      LevelBuilder builder(nullptr, Random, &contentFactory, size, size, false, none);
       PLevelMaker levelMaker = LevelMaker::emptyLevel(FurnitureType("MOUNTAIN"), true);
       level = model->buildMainLevel(std::move(builder), std::move(levelMaker));
       game = Game::splashScreen(std::move(model), CampaignBuilder::getEmptyCampaign(), std::move(contentFactory));
@@ -1108,6 +1557,187 @@ class Test {
       t.matching.addTarget(t.get(v.x, v.y));
   }
 
+  static bool isOpenForMatching(Position pos) {
+    return pos.canEnterEmpty({MovementTrait::WALK});
+  }
+
+  // Simple augmenting path search from every target, the way PositionMatching worked before the phases.
+  static int getMaxMatchingSize(const PositionSet& targets) {
+    unordered_map<Position, Position, CustomHash<Position>> matchOf;
+    function<bool(Position, PositionSet&)> tryMatch = [&](Position target, PositionSet& visited) {
+      for (auto v : target.neighbors8())
+        if (!targets.count(v) && isOpenForMatching(v) && !visited.count(v)) {
+          visited.insert(v);
+          if (!matchOf.count(v) || tryMatch(matchOf.at(v), visited)) {
+            matchOf[v] = target;
+            return true;
+          }
+        }
+      return false;
+    };
+    int ret = 0;
+    for (auto& target : targets) {
+      PositionSet visited;
+      if (tryMatch(target, visited))
+        ++ret;
+    }
+    return ret;
+  }
+
+  void testPositionMatching5() {
+    MatchingTest t;
+    PositionSet targets;
+    auto& furnitureFactory = t.game->getContentFactory()->furniture;
+    for (int i : Range(300)) {
+      auto pos = t.get(Random.get(10), Random.get(10));
+      if (Random.roll(3)) {
+        if (targets.count(pos)) {
+          targets.erase(pos);
+          t.matching.releaseTarget(pos);
+        } else if (!isOpenForMatching(pos)) {
+          targets.insert(pos);
+          t.matching.addTarget(pos);
+        }
+      } else {
+        if (auto furniture = pos.getFurniture(FurnitureLayer::MIDDLE))
+          pos.removeFurniture(furniture);
+        else
+          pos.addFurniture(furnitureFactory.getFurniture(FurnitureType("MOUNTAIN"), TribeId::getMonster()));
+        targets.erase(pos);
+        t.matching.updateMovement(pos);
+      }
+      if (Random.roll(2)) {
+        PositionSet used;
+        for (auto& target : targets)
+          if (auto match = t.matching.getMatch(target)) {
+            CHECK(target.neighbors8().contains(*match));
+            CHECK(isOpenForMatching(*match) && !targets.count(*match));
+            CHECK(!used.count(*match));
+            used.insert(*match);
+          }
+        CHECKEQ(used.size(), getMaxMatchingSize(targets));
+      }
+    }
+  }
+
+  // Times every update of a matching along a long corridor. The targets added below the corridor have no
+  // free square to take, so each of their searches covers the whole corridor.
+  void benchmarkPositionMatching() {
+    const int size = 200;
+    MatchingTest t(size);
+    vector<double> latencies;
+    auto measure = [&](Position pos, function<void()> update) {
+      auto begin = steady_clock::now();
+      update();
+      t.matching.getMatch(pos);
+      latencies.push_back(duration_cast<microseconds>(steady_clock::now() - begin).count());
+    };
+    const int y = size / 2;
+    for (int x : Range(1, size - 1)) {
+      auto pos = t.get(x, y);
+      measure(pos, [&] { t.free(pos); });
+    }
+    for (int x : Range(1, size - 1)) {
+      auto pos = t.get(x, y - 1);
+      measure(pos, [&] { t.matching.addTarget(pos); });
+    }
+    for (int x : Range(1, size - 1)) {
+      auto pos = t.get(x, y + 1);
+      measure(pos, [&] { t.matching.addTarget(pos); });
+    }
+    for (int x : Range(1, size - 1)) {
+      auto pos = t.get(x, y + 2);
+      measure(pos, [&] { t.free(pos); });
+    }
+    std::sort(latencies.begin(), latencies.end());
+    double total = 0;
+    for (auto elem : latencies)
+      total += elem;
+    std::cout << "PositionMatching: " << latencies.size() << " updates, average " << total / latencies.size()
+        << "us, 99th percentile " << latencies[latencies.size() * 99 / 100] << "us, worst " << latencies.back()
+        << "us" << std::endl;
+  }
+
+  // Calculates the extended territory from scratch, the way Territory did before keeping the distances.
+  static PositionSet getExtendedFromScratch(const Territory& territory, int minRadius, int maxRadius) {
+    unordered_map<Position, int, CustomHash<Position>> distance;
+    vector<Position> queue;
+    for (Position pos : territory.getAll()) {
+      distance[pos] = 1;
+      queue.push_back(pos);
+    }
+    for (int i = 0; i < queue.size(); ++i) {
+      Position pos = queue[i];
+      auto value = distance.at(pos);
+      for (Position v : pos.neighbors8())
+        if (!territory.contains(v) && !distance.count(v) && v.canEnterEmpty({MovementTrait::WALK})) {
+          distance[v] = value + 1;
+          if (value + 1 < maxRadius)
+            queue.push_back(v);
+        }
+    }
+    PositionSet ret;
+    for (auto& pos : queue)
+      if (distance.at(pos) >= minRadius)
+        ret.insert(pos);
+    return ret;
+  }
+
+  void testTerritory() {
+    MatchingTest t;
+    Territory territory;
+    auto check = [&] {
+      for (auto band : {make_pair(2, 10), make_pair(0, 5), make_pair(3, 4)}) {
+        auto expected = getExtendedFromScratch(territory, band.first, band.second);
+        auto& extended = territory.getExtended(band.first, band.second);
+        CHECKEQ(extended.size(), expected.size());
+        for (auto& pos : extended)
+          CHECK(expected.count(pos));
+        for (auto v : Rectangle(10, 10))
+          CHECKEQ(territory.isInExtended(t.get(v.x, v.y), band.first, band.second), expected.count(t.get(v.x, v.y)) > 0);
+      }
+    };
+    territory.insert(t.get(5, 5));
+    check();
+    auto& furnitureFactory = t.game->getContentFactory()->furniture;
+    for (int i : Range(300)) {
+      auto pos = t.get(Random.get(10), Random.get(10));
+      if (Random.roll(3)) {
+        if (territory.contains(pos))
+          territory.remove(pos);
+        else
+          territory.insert(pos);
+      } else {
+        if (auto furniture = pos.getFurniture(FurnitureLayer::MIDDLE))
+          pos.removeFurniture(furniture);
+        else
+          pos.addFurniture(furnitureFactory.getFurniture(FurnitureType("MOUNTAIN"), TribeId::getMonster()));
+        territory.updateMovement(pos);
+      }
+      check();
+    }
+  }
+
+  void testLevelBuilderCheckpoint() {
+    auto contentFactory = getContentFactory();
+    LevelBuilder builder(nullptr, Random, &contentFactory, 10, 10, false, none);
+    builder.putFurniture(Vec2(1, 1), FurnitureType("MOUNTAIN"));
+    auto checkpoint = builder.checkpoint();
+    builder.removeFurniture(Vec2(1, 1), FurnitureLayer::MIDDLE);
+    builder.putFurniture(Vec2(2, 2), FurnitureType("MOUNTAIN"));
+    builder.addAttrib(Vec2(3, 3), SquareAttrib::ROOM);
+    builder.setCovered(Vec2(3, 3), true);
+    auto stairKey = StairKey::getNew();
+    builder.modSquare(Vec2(4, 4))->setLandingLink(stairKey);
+    builder.restore(checkpoint);
+    CHECK(builder.isFurnitureType(Vec2(1, 1), FurnitureType("MOUNTAIN")));
+    CHECK(!builder.getFurniture(Vec2(2, 2), FurnitureLayer::MIDDLE));
+    CHECK(!builder.hasAttrib(Vec2(3, 3), SquareAttrib::ROOM));
+    CHECK(!builder.isCovered(Vec2(3, 3)));
+    // Changes made through modSquare() are documented to survive restore().
+    CHECK(builder.modSquare(Vec2(4, 4))->getLandingLink() == stairKey);
+  }
+
   void testDungeonLevel() {
     DungeonLevel level;
     CHECKEQ(level.level, 0);
@@ -1208,6 +1838,7 @@ class Test {
 void testAll() {
   Test().testStringConvertion();
   Test().testTimeQueue();
+  Test().testTimeQueueRandom();
   Test().testRectangleIterator();
   Test().testValueCheck();
   Test().testSplit();
@@ -1240,6 +1871,11 @@ void testAll() {
   Test().testReverse2();
   Test().testReverse3();
   Test().testOwnerPointer();
+  Test().testReadWriteArraySlotReuse();
+  Test().testBitTable();
+  Test().testTiledTable();
+  Test().testTableSerialization();
+  Test().testContentFactoryCopy();
   Test().testMinionEquipment1();
   Test().testMinionEquipmentItemDestroyed();
   Test().testMinionEquipmentUpdateItems();
@@ -1256,12 +1892,25 @@ void testAll() {
   Test().testContainerRangeMapConst();
   Test().testCacheTemplate();
   Test().testCacheTemplate2();
+  Test().testCacheStamped();
+  Test().testMemo();
+  Test().testCreatureAttrMemo();
+  Test().testCreatureAttrMemoEquipment();
+  Test().testProfiler();
+  Test().testMemoryReport();
+  Test().testObjectPool();
+  Test().testWorkerPool();
+  Test().testAsyncLogWorkers();
+  Test().testInventoryChangeEpoch();
   Test().testTextSerialization();
   Test().testPositionMatching1();
   Test().testPositionMatching2();
   Test().testPositionMatching3();
   Test().testPositionMatching4();
+  Test().testPositionMatching5();
+  Test().testTerritory();
   Test().testDungeonLevel();
+  Test().testLevelBuilderCheckpoint();
   Test().testRoofSupport1();
   Test().testRoofSupport2();
   Test().testRoofSupport3();
@@ -1277,3 +1926,7 @@ void testAll() {
   LastingEffects::runTests();
   INFO << "-----===== OK =====-----";
 }
+
+void benchmarkPositionMatching() {
+  Test().benchmarkPositionMatching();
+}
@@ -16,4 +16,5 @@
 #pragma once
 
 void testAll();
+void benchmarkPositionMatching();
 
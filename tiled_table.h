@@ -0,0 +1,90 @@
+#pragma once
+
+#include "util.h"
+
+/** A Table that keeps its elements in square tiles of (1 << TileBits) elements per side, so that
+    positions close to each other in any direction are close in memory. Meant for grids that are
+    updated and read in a radius around a point. Version 0 saves were written element by element, like Table.*/
+template <typename T, int TileBits = 3>
+class TiledTable {
+  public:
+  TiledTable(const Rectangle& rect, const T& value = T()) : bounds(rect),
+      tilesHeight((rect.height() + tileSize - 1) >> TileBits),
+      mem(new T[getNumTiles() << (2 * TileBits)]) {
+    for (int i : Range(getNumTiles() << (2 * TileBits)))
+      mem[i] = value;
+  }
+
+  explicit TiledTable(const Table<T>& table) : TiledTable(table.getBounds()) {
+    for (Vec2 v : bounds)
+      (*this)[v] = table[v];
+  }
+
+  TiledTable(TiledTable&&) = default;
+  TiledTable& operator = (TiledTable&&) = default;
+
+  const Rectangle& getBounds() const {
+    return bounds;
+  }
+
+  size_t getMemoryBytes() const {
+    return (size_t(getNumTiles()) << (2 * TileBits)) * sizeof(T);
+  }
+
+  T& operator[](const Vec2& vAbs) {
+    return mem[getIndex(vAbs)];
+  }
+
+  const T& operator[](const Vec2& vAbs) const {
+    return mem[getIndex(vAbs)];
+  }
+
+  template <class Archive>
+  void save(Archive& ar, const unsigned int version) const {
+    ar << bounds;
+    saveArray(ar, mem.get(), getNumTiles() << (2 * TileBits));
+  }
+
+  template <class Archive>
+  void load(Archive& ar, const unsigned int version) {
+    ar >> bounds;
+    tilesHeight = (bounds.height() + tileSize - 1) >> TileBits;
+    mem.reset(new T[getNumTiles() << (2 * TileBits)]);
+    if (version >= 1)
+      loadArray(ar, mem.get(), getNumTiles() << (2 * TileBits));
+    else
+      for (Vec2 v : bounds)
+        ar >> (*this)[v];
+  }
+
+  SERIALIZATION_CONSTRUCTOR(TiledTable)
+
+  private:
+  static constexpr int tileSize = 1 << TileBits;
+  static constexpr int tileMask = tileSize - 1;
+
+  int getNumTiles() const {
+    return ((bounds.width() + tileSize - 1) >> TileBits) * tilesHeight;
+  }
+
+  int getIndex(const Vec2& vAbs) const {
+#ifndef RELEASE
+    CHECK(vAbs.inRectangle(bounds)) << "Table index out of bounds " << bounds << " " << vAbs;
+#endif
+    int x = vAbs.x - bounds.left();
+    int y = vAbs.y - bounds.top();
+    int tile = (x >> TileBits) * tilesHeight + (y >> TileBits);
+    return (tile << (2 * TileBits)) + ((x & tileMask) << TileBits) + (y & tileMask);
+  }
+
+  Rectangle bounds;
+  int tilesHeight = 0;
+  unique_ptr<T[]> mem;
+};
+
+namespace cereal { namespace detail {
+template <typename T, int TileBits, typename BindingTag>
+struct Version<TiledTable<T, TileBits>, BindingTag> {
+  static const std::uint32_t version = 1;
+};
+}}
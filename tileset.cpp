@@ -212,7 +212,8 @@ Tile TileSet::symbol(const string& s, Color id, bool symbol) {
   return Tile::fromString(s, id, symbol);
 }
 
-TileSet::TileSet(const DirectoryPath& defaultDir, const DirectoryPath& modsDir) : defaultDir(defaultDir), modsDir(modsDir) {
+TileSet::TileSet(const DirectoryPath& defaultDir, const DirectoryPath& modsDir, optional<DirectoryPath> cacheDir)
+    : defaultDir(defaultDir), modsDir(modsDir), cacheDir(cacheDir) {
 }
 
 void TileSet::setTilePaths(const TilePaths& p) {
@@ -260,6 +261,115 @@ const Tile& TileSet::getTile(ViewId viewId, bool sprite) const {
 
 constexpr int textureWidth = 720;
 
+// Bump when the format of the atlas cache changes.
+constexpr int atlasCacheVersion = 1;
+
+// FNV-1a, which unlike std::hash gives the same value in every build, so the cache stays valid.
+static uint64_t hashBytes(uint64_t hash, const char* data, size_t size) {
+  for (size_t i = 0; i < size; ++i)
+    hash = (hash ^ (unsigned char) data[i]) * 1099511628211ULL;
+  return hash;
+}
+
+static uint64_t hashString(uint64_t hash, const string& s) {
+  return hashBytes(hash, s.data(), s.size() + 1);
+}
+
+static const uint64_t hashSeed = 14695981039346656037ULL;
+
+namespace {
+struct AtlasFrame {
+  string spriteName;
+  Vec2 pos;
+};
+}
+
+template <typename T>
+static void writeValue(ostream& out, const T& value) {
+  out.write((const char*) &value, sizeof(value));
+}
+
+template <typename T>
+static bool readValue(istream& in, T& value) {
+  return !!in.read((char*) &value, sizeof(value));
+}
+
+static void writeAtlasCache(const FilePath& path, uint64_t key, SDL::SDL_Surface* image,
+    const vector<AtlasFrame>& frames) {
+  ofstream out(path.getPath(), std::ios::binary);
+  writeValue(out, atlasCacheVersion);
+  writeValue(out, key);
+  writeValue(out, (int) frames.size());
+  for (auto& frame : frames) {
+    writeValue(out, (int) frame.spriteName.size());
+    out.write(frame.spriteName.data(), frame.spriteName.size());
+    writeValue(out, frame.pos.x);
+    writeValue(out, frame.pos.y);
+  }
+  for (int y : Range(image->h))
+    out.write((const char*) image->pixels + y * image->pitch, image->w * 4);
+  if (!out)
+    INFO << "Couldn't write tile atlas cache " << path;
+}
+
+static SDL::SDL_Surface* readAtlasCache(const FilePath& path, uint64_t key, vector<AtlasFrame>& frames) {
+  ifstream in(path.getPath(), std::ios::binary);
+  int version = 0;
+  uint64_t cachedKey = 0;
+  int numFrames = 0;
+  if (!readValue(in, version) || version != atlasCacheVersion || !readValue(in, cachedKey) || cachedKey != key ||
+      !readValue(in, numFrames))
+    return nullptr;
+  for (int i : Range(numFrames)) {
+    int length = 0;
+    if (!readValue(in, length) || length < 0 || length > 1000)
+      return nullptr;
+    AtlasFrame frame;
+    frame.spriteName.resize(length);
+    if (!in.read(&frame.spriteName[0], length) || !readValue(in, frame.pos.x) || !readValue(in, frame.pos.y))
+      return nullptr;
+    frames.push_back(std::move(frame));
+  }
+  SDL::SDL_Surface* image = Texture::createSurface(textureWidth, textureWidth);
+  for (int y : Range(image->h))
+    if (!in.read((char*) image->pixels + y * image->pitch, image->w * 4)) {
+      SDL::SDL_FreeSurface(image);
+      return nullptr;
+    }
+  return image;
+}
+
+static optional<string> readImage(const FilePath& file) {
+  ifstream in(file.getPath(), std::ios::binary);
+  if (!in)
+    return none;
+  stringstream ss;
+  ss << in.rdbuf();
+  return ss.str();
+}
+
+// Decodes the images on all cores. SDL_image isn't safe to initialize from many threads, so it's done first.
+static vector<SDL::SDL_Surface*> decodeImages(const vector<FilePath>& files, const vector<string>& contents) {
+  SDL::IMG_Init(SDL::IMG_INIT_PNG);
+  vector<SDL::SDL_Surface*> ret(files.size());
+  auto decode = [&] (int begin, int end) {
+    for (int i = begin; i < end; ++i)
+      ret[i] = SDL::IMG_Load_RW(SDL::SDL_RWFromConstMem(contents[i].data(), contents[i].size()), 1);
+  };
+  int numThreads = max<int>(1, min<int>(thread::hardware_concurrency(), files.size() / 8));
+  vector<thread> threads;
+  for (int i = 1; i < numThreads; ++i)
+    threads.push_back(makeThread([&decode, &files, i, numThreads] {
+      decode(i * files.size() / numThreads, (i + 1) * files.size() / numThreads);
+    }));
+  decode(0, files.size() / numThreads);
+  for (auto& t : threads)
+    t.join();
+  for (int i : All(files))
+    CHECK(ret[i]) << files[i] << ": " << SDL::IMG_GetError();
+  return ret;
+}
+
 bool TileSet::loadTilesFromDir(const DirectoryPath& path, Vec2 size, bool overwrite) {
   if (!path.exists())
     return false;
@@ -267,47 +377,80 @@ bool TileSet::loadTilesFromDir(const DirectoryPath& path, Vec2 size, bool overwr
   auto files = path.getFiles().filter([](const FilePath& f) { return f.hasSuffix(imageSuf);});
   if (files.empty())
     return false;
-  int rowLength = textureWidth / size.x;
-  SDL::SDL_Surface* image = Texture::createSurface(textureWidth, textureWidth);
-  SDL::SDL_SetSurfaceBlendMode(image, SDL::SDL_BLENDMODE_NONE);
-  CHECK(image) << SDL::SDL_GetError();
-  int frameCount = 0;
-  vector<pair<string, Vec2>> addedPositions;
-  for (int i : All(files)) {
-    SDL::SDL_Surface* im = SDL::IMG_Load(files[i].getPath());
-    SDL::SDL_SetSurfaceBlendMode(im, SDL::SDL_BLENDMODE_NONE);
-    CHECK(im) << files[i] << ": "<< SDL::IMG_GetError();
-    USER_CHECK((im->w % size.x == 0) && im->h == size.y) << files[i] << " has wrong size " << im->w << " " << im->h;
-    string fileName = files[i].getFileName();
-    string spriteName = fileName.substr(0, fileName.size() - imageSuf.size());
+  // Sorted, so that the atlas layout doesn't depend on the order of the directory entries.
+  std::sort(files.begin(), files.end(),
+      [](const FilePath& f1, const FilePath& f2) { return strcmp(f1.getFileName(), f2.getFileName()) < 0; });
+  auto getSpriteName = [](const FilePath& file) {
+    string fileName = file.getFileName();
+    return fileName.substr(0, fileName.size() - imageSuf.size());
+  };
+  vector<FilePath> sources;
+  for (auto& file : files) {
+    auto spriteName = getSpriteName(file);
     if (tileCoords.count(spriteName)) {
       if (overwrite)
         tileCoords.erase(spriteName);
       else
         continue;
     }
-    for (int frame : Range(im->w / size.x)) {
-      SDL::SDL_Rect dest;
-      int posX = frameCount % rowLength;
-      int posY = frameCount / rowLength;
-      dest.x = size.x * posX;
-      dest.y = size.y * posY;
-      CHECK(dest.x < textureWidth && dest.y < textureWidth);
-      SDL::SDL_Rect src;
-      src.x = frame * size.x;
-      src.y = 0;
-      src.w = size.x;
-      src.h = size.y;
-      SDL_BlitSurface(im, &src, image, &dest);
-      addedPositions.emplace_back(spriteName, Vec2(posX, posY));
-      INFO << "Loading tile sprite " << fileName << " at " << posX << "," << posY;
-      ++frameCount;
+    sources.push_back(file);
+  }
+  // Modification times don't survive copying or unpacking the game, so the key covers the size and
+  // contents of every image. Reading the files is cheap next to decoding them, and a miss decodes from memory.
+  vector<string> contents;
+  uint64_t key = hashBytes(hashSeed, (const char*) &size, sizeof(size));
+  for (auto& file : sources) {
+    auto data = readImage(file);
+    USER_CHECK(!!data) << "Couldn't read " << file;
+    auto length = (int64_t) data->size();
+    key = hashBytes(hashString(key, file.getFileName()), (const char*) &length, sizeof(length));
+    key = hashBytes(key, data->data(), data->size());
+    contents.push_back(std::move(*data));
+  }
+  optional<FilePath> cachePath;
+  if (cacheDir)
+    cachePath = cacheDir->file("atlas_" + toString(hashString(hashSeed, path.getPath() + toString(size.x))));
+  vector<AtlasFrame> frames;
+  SDL::SDL_Surface* image = cachePath && cachePath->exists() ? readAtlasCache(*cachePath, key, frames) : nullptr;
+  if (image)
+    INFO << "Loaded " << frames.size() << " tile frames from cache " << *cachePath;
+  else {
+    frames.clear();
+    int rowLength = textureWidth / size.x;
+    image = Texture::createSurface(textureWidth, textureWidth);
+    SDL::SDL_SetSurfaceBlendMode(image, SDL::SDL_BLENDMODE_NONE);
+    CHECK(image) << SDL::SDL_GetError();
+    auto images = decodeImages(sources, contents);
+    for (int i : All(sources)) {
+      SDL::SDL_Surface* im = images[i];
+      SDL::SDL_SetSurfaceBlendMode(im, SDL::SDL_BLENDMODE_NONE);
+      USER_CHECK((im->w % size.x == 0) && im->h == size.y) << sources[i] << " has wrong size " << im->w << " " << im->h;
+      for (int frame : Range(im->w / size.x)) {
+        SDL::SDL_Rect dest;
+        int posX = frames.size() % rowLength;
+        int posY = frames.size() / rowLength;
+        dest.x = size.x * posX;
+        dest.y = size.y * posY;
+        CHECK(dest.x < textureWidth && dest.y < textureWidth);
+        SDL::SDL_Rect src;
+        src.x = frame * size.x;
+        src.y = 0;
+        src.w = size.x;
+        src.h = size.y;
+        SDL_BlitSurface(im, &src, image, &dest);
+        frames.push_back(AtlasFrame{getSpriteName(sources[i]), Vec2(posX, posY)});
+      }
+      SDL::SDL_FreeSurface(im);
+    }
+    INFO << "Loaded " << frames.size() << " tile frames from " << sources.size() << " files in " << path;
+    if (cachePath) {
+      cacheDir->createIfDoesntExist();
+      writeAtlasCache(*cachePath, key, image, frames);
     }
-    SDL::SDL_FreeSurface(im);
   }
   textures.push_back(unique<Texture>(image));
-  for (auto& pos : addedPositions)
-    tileCoords[pos.first].push_back({size, pos.second, textures.back().get()});
+  for (auto& frame : frames)
+    tileCoords[frame.spriteName].push_back({size, frame.pos, textures.back().get()});
   SDL::SDL_FreeSurface(image);
   return true;
 }
@@ -18,7 +18,8 @@ struct TileCoord {
 
 class TileSet {
   public:
-  TileSet(const DirectoryPath& defaultDir, const DirectoryPath& modsDir);
+  /** The packed atlases are cached in cacheDir, if given.*/
+  TileSet(const DirectoryPath& defaultDir, const DirectoryPath& modsDir, optional<DirectoryPath> cacheDir = none);
   void setTilePaths(const TilePaths&);
   const TilePaths& getTilePaths() const;
   void reload();
@@ -31,6 +32,7 @@ class TileSet {
   optional<TilePaths> tilePaths;
   DirectoryPath defaultDir;
   DirectoryPath modsDir;
+  optional<DirectoryPath> cacheDir;
   friend class TileCoordLookup;
   void addTile(string, Tile);
   void addSymbol(string, Tile);
@@ -19,135 +19,191 @@
 #include "creature.h"
 #include "view_object.h"
 
-template <class Archive> 
-void TimeQueue::serialize(Archive& ar, const unsigned int version) { 
+template <class Archive>
+void TimeQueue::serialize(Archive& ar, const unsigned int version) {
+  EntityMap<Creature, ExtendedTime> timeMap;
+  map<ExtendedTime, SerialQueue> queue;
+  if (Archive::is_saving::value) {
+    for (auto& c : creatures)
+      timeMap.set(c.get(), getExtendedTime(schedules.at(c.get()).key));
+    auto addBucket = [&] (TimeKey key, const Bucket& bucket) {
+      if (bucket.numScheduled == 0)
+        return;
+      auto& serialQueue = queue[getExtendedTime(key)];
+      auto addLine = [&] (const Line& line, deque<Creature*>& to) {
+        for (auto& entry : line.entries)
+          if (isCurrent(entry)) {
+            to.push_back(entry.creature);
+            serialQueue.orderMap.set(entry.creature, schedules.at(entry.creature).order);
+          }
+      };
+      addLine(bucket.players, serialQueue.players);
+      addLine(bucket.nonPlayers, serialQueue.nonPlayers);
+    };
+    for (int i = 0; i < buckets.size(); ++i)
+      addBucket(firstKey + i, buckets[i]);
+    for (auto& elem : farBuckets)
+      addBucket(elem.first, elem.second);
+  }
   ar(creatures, timeMap, queue);
+  if (Archive::is_loading::value) {
+    // Creatures haven't been fully loaded yet, so the saved split into players and non-players is used.
+    for (auto& elem : queue) {
+      auto key = getKey(elem.first);
+      for (auto c : elem.second.players)
+        if (c)
+          schedule(c, key, true, false);
+      for (auto c : elem.second.nonPlayers)
+        if (c)
+          schedule(c, key, false, false);
+    }
+  }
 }
 
 SERIALIZABLE(TimeQueue);
 
-void TimeQueue::addCreature(PCreature c, LocalTime time) {
-  timeMap.set(c.get(), time);
-  queue[time].push(c.get());
-  creatures.push_back(std::move(c));
+TimeQueue::TimeKey TimeQueue::getKey(ExtendedTime time) {
+  return 2 * (TimeKey) time.time.getInternal() + (time.extraTurn ? 1 : 0);
 }
 
-LocalTime TimeQueue::getTime(const Creature* c) {
-  return timeMap.getOrFail(c).time;
+TimeQueue::ExtendedTime TimeQueue::getExtendedTime(TimeKey key) {
+  ExtendedTime ret(LocalTime((int) (key >> 1)));
+  ret.extraTurn = (key & 1);
+  return ret;
 }
 
-static void clearNull(deque<Creature*>& q) {
-  while (!q.empty() && q.back() == nullptr)
-    q.pop_back();
-  while (!q.empty() && q.front() == nullptr)
-    q.pop_front();
+static double getDouble(long long key) {
+  return (double) (key >> 1) + ((key & 1) ? 0.5 : 0);
 }
 
-void TimeQueue::Queue::clearNull() {
-  ::clearNull(players);
-  ::clearNull(nonPlayers);
+TimeQueue::Bucket& TimeQueue::getBucket(TimeKey key) {
+  if (buckets.empty() && farBuckets.empty())
+    firstKey = key;
+  if (key < firstKey) {
+    if (firstKey - key < maxSpan) {
+      buckets.insert(buckets.begin(), firstKey - key, Bucket());
+    } else {
+      for (int i = 0; i < buckets.size(); ++i)
+        if (buckets[i].numScheduled > 0)
+          farBuckets[firstKey + i] = std::move(buckets[i]);
+      buckets.clear();
+      buckets.emplace_back();
+    }
+    firstKey = key;
+  }
+  if (key - firstKey < (TimeKey) buckets.size())
+    return buckets[key - firstKey];
+  if (key - firstKey < maxSpan) {
+    buckets.resize(key - firstKey + 1);
+    return buckets.back();
+  }
+  return farBuckets[key];
 }
 
-void TimeQueue::Queue::push(Creature* c) {
-  clearNull();
-  if (c->isPlayer()) {
-    int order = players.empty() ? 0 : orderMap.getOrFail(players.back()) + 1;
-    orderMap.set(c, order);
-    players.push_back(c);
-  } else {
-    int order = nonPlayers.empty() ? 1000000000 : orderMap.getOrFail(nonPlayers.back()) + 1;
-    orderMap.set(c, order);
-    nonPlayers.push_back(c);
-  }
+void TimeQueue::schedule(Creature* c, TimeKey key, bool player, bool atFront) {
+  auto& bucket = getBucket(key);
+  auto& line = player ? bucket.players : bucket.nonPlayers;
+  // Players get lower orders than everyone else, so that compareOrder puts them first.
+  const int nonPlayerOrder = 1000000000;
+  int order = (player ? 0 : nonPlayerOrder) + (atFront ? --line.frontOrder : line.backOrder++);
+  Entry entry {c, ++lastTicket};
+  if (atFront)
+    line.entries.push_front(entry);
+  else
+    line.entries.push_back(entry);
+  ++bucket.numScheduled;
+  schedules[c] = Schedule{key, order, entry.ticket};
 }
 
-void TimeQueue::Queue::pushFront(Creature* c) {
-  clearNull();
-  if (c->isPlayer()) {
-    int order = players.empty() ? 0 : orderMap.getOrFail(players.front()) - 1;
-    orderMap.set(c, order);
-    players.push_front(c);
-  } else {
-    int order = nonPlayers.empty() ? 1000000000 : orderMap.getOrFail(nonPlayers.front()) - 1;
-    orderMap.set(c, order);
-    nonPlayers.push_front(c);
-  }
+void TimeQueue::unschedule(const Creature* c) {
+  --getBucket(schedules.at(c).key).numScheduled;
+  // Invalidates the creature's entry in the bucket.
+  schedules.at(c).ticket = 0;
 }
 
-bool TimeQueue::Queue::empty() {
-  clearNull();
-  return players.empty() && nonPlayers.empty();
+bool TimeQueue::isCurrent(const Entry& entry) const {
+  auto it = schedules.find(entry.creature);
+  return it != schedules.end() && it->second.ticket == entry.ticket;
 }
 
-Creature* TimeQueue::Queue::front() {
-  clearNull();
-  if (!players.empty())
-    return players.front();
-  else
-    return nonPlayers.front();
+Creature* TimeQueue::getFront(Bucket& bucket) {
+  for (auto line : {&bucket.players, &bucket.nonPlayers}) {
+    while (!line->entries.empty() && !isCurrent(line->entries.front()))
+      line->entries.pop_front();
+    if (!line->entries.empty())
+      return line->entries.front().creature;
+  }
+  return nullptr;
 }
 
-void TimeQueue::Queue::popFront() {
-  if (!players.empty())
-    return players.pop_front();
-  else
-    return nonPlayers.pop_front();
+void TimeQueue::dropEmptyBuckets() {
+  while (1) {
+    while (!buckets.empty() && buckets.front().numScheduled == 0) {
+      buckets.pop_front();
+      ++firstKey;
+    }
+    if (buckets.empty() && !farBuckets.empty())
+      firstKey = farBuckets.begin()->first;
+    while (!farBuckets.empty() && farBuckets.begin()->first < firstKey + maxSpan) {
+      auto key = farBuckets.begin()->first;
+      if (key - firstKey >= (TimeKey) buckets.size())
+        buckets.resize(key - firstKey + 1);
+      buckets[key - firstKey] = std::move(farBuckets.begin()->second);
+      farBuckets.erase(farBuckets.begin());
+    }
+    if (buckets.empty() || buckets.front().numScheduled > 0)
+      break;
+  }
 }
 
-void TimeQueue::Queue::erase(Creature* c) {
-  auto eraseFrom = [&c] (deque<Creature*>& queue) {
-    for (int i : All(queue))
-      if (queue[i] == c) {
-        queue[i] = nullptr;
-        return true;
-      }
-    return false;
-  };
-  CHECK(eraseFrom(players) || eraseFrom(nonPlayers));
+void TimeQueue::addCreature(PCreature c, LocalTime time) {
+  schedule(c.get(), getKey(time), c->isPlayer(), false);
+  creatures.push_back(std::move(c));
+}
+
+LocalTime TimeQueue::getTime(const Creature* c) {
+  return getExtendedTime(schedules.at(c).key).time;
 }
 
 void TimeQueue::increaseTime(Creature* c, TimeInterval diff) {
-  auto& time = timeMap.getOrFail(c);
-  queue.at(time).erase(c);
+  auto time = getExtendedTime(schedules.at(c).key);
+  unschedule(c);
   time.time += diff;
   time.extraTurn = false;
-  queue[time].push(c);
+  schedule(c, getKey(time), c->isPlayer(), false);
 }
 
 void TimeQueue::makeExtraMove(Creature* c) {
-  auto& time = timeMap.getOrFail(c);
-  queue.at(time).erase(c);
-  if (!time.extraTurn)
-    time.extraTurn = true;
-  else {
-    time.time += 1_visible;
-    time.extraTurn = false;
-  }
-  queue[time].push(c);
+  auto key = schedules.at(c).key;
+  unschedule(c);
+  // The key right after a regular move is its extra move, and the one after an extra move is the next turn.
+  schedule(c, key + 1, c->isPlayer(), false);
 }
 
 bool TimeQueue::hasExtraMove(Creature* c) {
-  return timeMap.getOrFail(c).extraTurn;
+  return schedules.at(c).key & 1;
 }
 
 void TimeQueue::postponeMove(Creature* c) {
   CHECK(contains(c));
-  auto time = timeMap.getOrFail(c);
-  queue.at(time).erase(c);
-  queue.at(time).push(c);
+  auto key = schedules.at(c).key;
+  unschedule(c);
+  schedule(c, key, c->isPlayer(), false);
 }
 
 void TimeQueue::moveNow(Creature* c) {
   CHECK(contains(c));
-  auto time = timeMap.getOrFail(c);
-  queue.at(time).erase(c);
-  queue.at(time).pushFront(c);
+  auto key = schedules.at(c).key;
+  unschedule(c);
+  schedule(c, key, c->isPlayer(), true);
+}
+
+static bool sameTurn(long long key, long long currentKey) {
+  return (key >> 1) == (currentKey >> 1) && (!(key & 1) || (currentKey & 1));
 }
 
 bool TimeQueue::willMoveThisTurn(const Creature* c) {
-  auto hisTime = timeMap.getOrFail(c);
-  auto curTime = queue.begin()->first;
-  return hisTime.time == curTime.time && (!hisTime.extraTurn || curTime.extraTurn);
+  return sameTurn(schedules.at(c).key, firstKey);
 }
 
 bool TimeQueue::compareOrder(const Creature* c1, const Creature* c2) {
@@ -157,21 +213,15 @@ bool TimeQueue::compareOrder(const Creature* c1, const Creature* c2) {
     return false;
   if (!willMoveThisTurn(c1))
     return c1->getLastMoveCounter() < c2->getLastMoveCounter();
-  auto time1 = timeMap.getOrFail(c1);
-  auto time2 = timeMap.getOrFail(c2);
-  if (time1 < time2)
-    return true;
-  if (time2 < time1)
-    return false;
-  auto& orderMap = queue.at(time1).orderMap;
-  return orderMap.getOrFail(c1) < orderMap.getOrFail(c2);
+  auto& schedule1 = schedules.at(c1);
+  auto& schedule2 = schedules.at(c2);
+  if (schedule1.key != schedule2.key)
+    return schedule1.key < schedule2.key;
+  return schedule1.order < schedule2.order;
 }
 
-bool TimeQueue::contains(Creature* c) const {
-  for (auto& creature : creatures)
-    if (creature.get() == c)
-      return true;
-  return false;
+bool TimeQueue::contains(const Creature* c) const {
+  return schedules.count(c);
 }
 
 TimeQueue::TimeQueue() {}
@@ -179,7 +229,8 @@ TimeQueue::TimeQueue() {}
 PCreature TimeQueue::removeCreature(Creature* cRef) {
   for (int i : All(creatures))
     if (creatures[i].get() == cRef) {
-      queue.at(timeMap.getOrFail(cRef)).erase(cRef);
+      unschedule(cRef);
+      schedules.erase(cRef);
       PCreature ret = std::move(creatures[i]);
       creatures.removeIndexPreserveOrder(i);
       return ret;
@@ -192,40 +243,38 @@ vector<Creature*> TimeQueue::getAllCreatures() const {
   return getWeakPointers(creatures);
 }
 
+vector<Creature*> TimeQueue::getCreaturesMovingNow() {
+  vector<Creature*> ret;
+  if (creatures.empty())
+    return ret;
+  dropEmptyBuckets();
+  auto& bucket = buckets.front();
+  for (auto line : {&bucket.players, &bucket.nonPlayers})
+    for (auto& entry : line->entries)
+      if (isCurrent(entry))
+        ret.push_back(entry.creature);
+  return ret;
+}
+
 Creature* TimeQueue::getNextCreature(double maxTime) {
   if (creatures.empty())
     return nullptr;
-  while (1) {
-    CHECK(!queue.empty());
-    if (!queue.begin()->second.empty())
-      break;
-    queue.erase(queue.begin());
-  }
-  auto nowTime = queue.begin()->first;
-  if (nowTime.getDouble() > maxTime)
+  dropEmptyBuckets();
+  CHECK(!buckets.empty());
+  if (getDouble(firstKey) > maxTime)
     return nullptr;
-  auto& q = queue.begin()->second;
-  if (!nowTime.extraTurn) {
-    auto nextQueue = ++queue.begin();
-    if (nextQueue != queue.end()) {
-      if (nextQueue->first.time == nowTime.time && !nextQueue->second.empty() && nextQueue->second.front()->isPlayer())
-        return nextQueue->second.front();
-    }
-  }
-  return q.front();
+  // Players with an extra move go before the regular moves of everyone else.
+  if (!(firstKey & 1) && buckets.size() > 1)
+    if (auto c = getFront(buckets[1]))
+      if (c->isPlayer())
+        return c;
+  return getFront(buckets.front());
 }
 
 TimeQueue::ExtendedTime::ExtendedTime() {}
 
 TimeQueue::ExtendedTime::ExtendedTime(LocalTime t) : time(t) {}
 
-double TimeQueue::ExtendedTime::getDouble() const {
-  double ret = time.getDouble();
-  if (extraTurn)
-    ret += 0.5;
-  return ret;
-}
-
 bool TimeQueue::ExtendedTime::operator < (TimeQueue::ExtendedTime o) const {
   return time < o.time || (time == o.time && !extraTurn && o.extraTurn);
 }
@@ -28,6 +28,9 @@ class TimeQueue {
   TimeQueue();
   Creature* getNextCreature(double maxTime);
   vector<Creature*> getAllCreatures() const;
+  /** Returns the creatures scheduled for the current time, in the order in which they will move, unless
+      something changes their time in the meantime. Doesn't include extra moves.*/
+  vector<Creature*> getCreaturesMovingNow();
   void addCreature(PCreature, LocalTime time);
   PCreature removeCreature(Creature*);
   LocalTime getTime(const Creature*);
@@ -43,34 +46,67 @@ class TimeQueue {
   void serialize(Archive& ar, const unsigned int version);
 
   private:
-  bool contains(Creature*) const;
+  bool contains(const Creature*) const;
 
   vector<PCreature> SERIAL(creatures);
-  struct Queue {
-    void push(Creature*);
-    void pushFront(Creature*);
-    bool empty();
-    Creature* front();
-    void popFront();
-    void erase(Creature*);
-    deque<Creature*> SERIAL(players);
-    deque<Creature*> SERIAL(nonPlayers);
-    EntityMap<Creature, int> SERIAL(orderMap);
-    SERIALIZE_ALL(players, nonPlayers, orderMap)
 
-    private:
-    void clearNull();
+  // Time of a move, encoded as twice the time, plus one for extra moves, so that extra moves come right after
+  // the regular moves of the same time.
+  using TimeKey = long long;
+
+  // A creature's current place in the queue. Entries in the buckets aren't removed when a creature is
+  // rescheduled, instead only the entry with the creature's latest ticket counts.
+  struct Schedule {
+    TimeKey key;
+    int order;
+    long long ticket;
+  };
+  struct Entry {
+    Creature* creature;
+    long long ticket;
+  };
+  struct Line {
+    deque<Entry> entries;
+    int frontOrder = 0;
+    int backOrder = 0;
+  };
+  // All moves of one TimeKey. Players always move before everyone else.
+  struct Bucket {
+    Line players;
+    Line nonPlayers;
+    int numScheduled = 0;
   };
+  Bucket& getBucket(TimeKey);
+  void schedule(Creature*, TimeKey, bool player, bool atFront);
+  void unschedule(const Creature*);
+  bool isCurrent(const Entry&) const;
+  Creature* getFront(Bucket&);
+  void dropEmptyBuckets();
+
+  unordered_map<const Creature*, Schedule> schedules;
+  long long lastTicket = 0;
+  // Buckets of consecutive keys starting from firstKey. Keys further than maxSpan in the future are kept
+  // in farBuckets until the current time gets close to them.
+  deque<Bucket> buckets;
+  TimeKey firstKey = 0;
+  map<TimeKey, Bucket> farBuckets;
+  static constexpr int maxSpan = 1024;
+
+  // The queue is saved as an ordered map of times, like it was before buckets were introduced.
   struct ExtendedTime {
     ExtendedTime();
     ExtendedTime(LocalTime);
-    double getDouble() const;
     bool operator < (ExtendedTime) const;
     LocalTime SERIAL(time);
     bool SERIAL(extraTurn) = false;
     SERIALIZE_ALL(time, extraTurn)
   };
-  map<ExtendedTime, Queue> SERIAL(queue);
-  EntityMap<Creature, ExtendedTime> SERIAL(timeMap);
+  struct SerialQueue {
+    deque<Creature*> SERIAL(players);
+    deque<Creature*> SERIAL(nonPlayers);
+    EntityMap<Creature, int> SERIAL(orderMap);
+    SERIALIZE_ALL(players, nonPlayers, orderMap)
+  };
+  static TimeKey getKey(ExtendedTime);
+  static ExtendedTime getExtendedTime(TimeKey);
 };
-
@@ -927,6 +927,53 @@ AsyncLoop::~AsyncLoop() {
   finishAndWait();
 }
 
+WorkerPool::WorkerPool(int numThreads) {
+  for (int i = 0; i < numThreads; ++i)
+    threads.push_back(makeThread([this] { workerLoop(); }));
+}
+
+WorkerPool::~WorkerPool() {
+  {
+    std::unique_lock<std::mutex> lock(mut);
+    done = true;
+  }
+  jobAdded.notify_all();
+  for (auto& t : threads)
+    t.join();
+}
+
+bool WorkerPool::runNext(std::unique_lock<std::mutex>& lock) {
+  if (nextIndex >= jobSize)
+    return false;
+  int index = nextIndex++;
+  lock.unlock();
+  job(index);
+  lock.lock();
+  if (++numFinished == jobSize)
+    jobFinished.notify_all();
+  return true;
+}
+
+void WorkerPool::workerLoop() {
+  std::unique_lock<std::mutex> lock(mut);
+  while (!done)
+    if (!runNext(lock))
+      jobAdded.wait(lock);
+}
+
+void WorkerPool::run(int num, function<void(int)> fun) {
+  std::unique_lock<std::mutex> lock(mut);
+  job = std::move(fun);
+  jobSize = num;
+  nextIndex = 0;
+  numFinished = 0;
+  jobAdded.notify_all();
+  while (runNext(lock)) {}
+  while (numFinished < jobSize)
+    jobFinished.wait(lock);
+  job = nullptr;
+  jobSize = 0;
+}
 
 #ifdef OSX // see thread comment in stdafx.h
 static thread::attributes getAttributes() {
@@ -872,6 +872,10 @@ class Table {
     return bounds;
   }
 
+  size_t getMemoryBytes() const {
+    return size_t(bounds.w) * bounds.h * sizeof(T);
+  }
+
   Table& operator = (Table&& other) = default;
   Table& operator = (const Table& other) {
     bounds = other.bounds;
@@ -940,16 +944,18 @@ class Table {
   template <class Archive>
   void save(Archive& ar, const unsigned int version) const {
     ar << bounds;
-    for (Vec2 v : bounds)
-      ar << (*this)[v];
+    saveArray(ar, mem.get(), bounds.w * bounds.h);
   }
 
   template <class Archive>
   void load(Archive& ar, const unsigned int version) {
     ar >> bounds;
     mem.reset(new T[bounds.width() * bounds.height()]);
-    for (Vec2 v : bounds)
-      ar >> (*this)[v];
+    if (version >= 1)
+      loadArray(ar, mem.get(), bounds.w * bounds.h);
+    else
+      for (Vec2 v : bounds)
+        ar >> (*this)[v];
   }
 
   SERIALIZATION_CONSTRUCTOR(Table)
@@ -959,12 +965,222 @@ class Table {
   unique_ptr<T[]> mem;
 };
 
+/** Packs the values into bits, column by column. Non-const access returns a BitReference instead of bool&,
+    so copy the value into a bool, not auto, when it mustn't follow later changes.*/
+template <>
+class Table<bool> {
+  public:
+  typedef unsigned long long Word;
+
+  class BitReference {
+    public:
+    BitReference(Word& w, Word m) : word(w), mask(m) {}
+    operator bool() const {
+      return word & mask;
+    }
+    BitReference& operator = (bool value) {
+      if (value)
+        word |= mask;
+      else
+        word &= ~mask;
+      return *this;
+    }
+    BitReference& operator = (const BitReference& other) {
+      return *this = bool(other);
+    }
+
+    private:
+    Word& word;
+    Word mask;
+  };
+
+  Table(Table&& t) = default;
+
+  Table(const Table& t) : Table(t.bounds) {
+    for (int i : Range(getNumWords()))
+      mem[i] = t.mem[i];
+  }
+
+  Table(int x, int y, int w, int h) : Table(Rectangle(x, y, x + w, y + h)) {
+  }
+
+  Table(const Rectangle& rect) : bounds(rect), mem(new Word[getNumWords()]) {
+    for (int i : Range(getNumWords()))
+      mem[i] = 0;
+  }
+
+  Table(const Rectangle& rect, bool value) : Table(rect) {
+    if (value)
+      fill(bounds, true);
+  }
+
+  Table(int w, int h) : Table(0, 0, w, h) {
+  }
+
+  Table(Vec2 size) : Table(size.x, size.y) {
+  }
+
+  Table(int x, int y, int width, int height, bool value) : Table(Rectangle(x, y, x + width, y + height), value) {
+  }
+
+  Table(int width, int height, bool value) : Table(0, 0, width, height, value) {
+  }
+
+  Table(Vec2 size, bool value) : Table(size.x, size.y, value) {
+  }
+
+  const Rectangle& getBounds() const {
+    return bounds;
+  }
+
+  size_t getMemoryBytes() const {
+    return getNumWords() * sizeof(Word);
+  }
+
+  Table& operator = (Table&& other) = default;
+  Table& operator = (const Table& other) {
+    bounds = other.bounds;
+    mem.reset(new Word[getNumWords()]);
+    for (int i : Range(getNumWords()))
+      mem[i] = other.mem[i];
+    return *this;
+  }
+
+  int getWidth() const {
+    return bounds.w;
+  }
+  int getHeight() const {
+    return bounds.h;
+  }
+
+  template <typename Ref, typename TablePtr>
+  class RowAccessBase {
+    public:
+    RowAccessBase(TablePtr t, int x) : table(t), px(x) {};
+    Ref operator[](int ind) const {
+      return (*table)[Vec2(px, ind)];
+    }
+
+    private:
+    TablePtr table;
+    int px;
+  };
+
+  typedef RowAccessBase<BitReference, Table*> RowAccess;
+  typedef RowAccessBase<bool, const Table*> ConstRowAccess;
+
+  RowAccess operator[](int ind) {
+    return RowAccess(this, ind);
+  }
+
+  ConstRowAccess operator[](int ind) const {
+    return ConstRowAccess(this, ind);
+  }
+
+  BitReference operator[](const Vec2& vAbs) {
+    int index = getIndex(vAbs);
+    return BitReference(mem[index / wordBits], Word(1) << (index % wordBits));
+  }
+
+  bool operator[](const Vec2& vAbs) const {
+    int index = getIndex(vAbs);
+    return (mem[index / wordBits] >> (index % wordBits)) & 1;
+  }
+
+  void fill(const Rectangle& rect, bool value) {
+    forEachWord(rect, [&](Word& word, Word mask) {
+      if (value)
+        word |= mask;
+      else
+        word &= ~mask;
+      return true;
+    });
+  }
+
+  template <class Archive>
+  void save(Archive& ar, const unsigned int version) const {
+    ar << bounds;
+    saveArray(ar, mem.get(), getNumWords());
+  }
+
+  template <class Archive>
+  void load(Archive& ar, const unsigned int version) {
+    ar >> bounds;
+    mem.reset(new Word[getNumWords()]);
+    if (version >= 1)
+      loadArray(ar, mem.get(), getNumWords());
+    else
+      for (Vec2 v : bounds) {
+        bool value;
+        ar >> value;
+        (*this)[v] = value;
+      }
+  }
+
+  SERIALIZATION_CONSTRUCTOR(Table)
+
+  private:
+  static constexpr int wordBits = 64;
+
+  int getNumWords() const {
+    return (bounds.w * bounds.h + wordBits - 1) / wordBits;
+  }
+
+  int getIndex(const Vec2& vAbs) const {
+#ifndef RELEASE
+    CHECK(vAbs.inRectangle(bounds)) <<
+        "Table index out of bounds " << bounds << " " << vAbs;
+#endif
+    return (vAbs.x - bounds.px) * bounds.h + vAbs.y - bounds.py;
+  }
+
+  // Calls fun(word, mask) for every word covering the rectangle, until it returns false.
+  // Columns are stored one after another, so a rectangle of full height is a single range of bits.
+  template <typename Fun>
+  void forEachWord(const Rectangle& rectAbs, Fun fun) {
+    if (!bounds.intersects(rectAbs))
+      return;
+    auto rect = rectAbs.intersection(bounds);
+    auto forRange = [&](int begin, int end) {
+      while (begin < end) {
+        int index = begin / wordBits;
+        int offset = begin % wordBits;
+        int num = min(wordBits - offset, end - begin);
+        Word mask = (num == wordBits ? ~Word(0) : ((Word(1) << num) - 1)) << offset;
+        if (!fun(mem[index], mask))
+          return false;
+        begin += num;
+      }
+      return true;
+    };
+    if (rect.py == bounds.py && rect.h == bounds.h)
+      forRange(getIndex(rect.topLeft()), getIndex(rect.topLeft()) + rect.w * rect.h);
+    else
+      for (int x : rect.getXRange()) {
+        int begin = getIndex(Vec2(x, rect.py));
+        if (!forRange(begin, begin + rect.h))
+          return;
+      }
+  }
+
+  Rectangle bounds;
+  unique_ptr<Word[]> mem;
+};
+
+// Version 1 stores the elements in bulk, see saveArray().
+namespace cereal { namespace detail {
+template <typename T, typename BindingTag>
+struct Version<Table<T>, BindingTag> {
+  static const std::uint32_t version = 1;
+};
+}}
+
 template<typename T>
 class DirtyTable {
   public:
   DirtyTable(Rectangle bounds, T dirty) : val(bounds), dirty(bounds, 0), dirtyVal(dirty) {}
 
-  const T& getValue(Vec2 v) const {
+  decltype(auto) getValue(Vec2 v) const {
     return dirty[v] < counter ? dirtyVal : val[v];
   }
 
@@ -1620,6 +1836,31 @@ class AsyncLoop {
   thread t;
 };
 
+/** Threads that are started once and then wait for jobs, so that short parallel jobs don't pay for
+    creating and joining threads every time.*/
+class WorkerPool {
+  public:
+  WorkerPool(int numThreads);
+  ~WorkerPool();
+
+  /** Calls fun with every index in [0, num) and returns when all calls are done. The calling thread takes
+      indices too, so the job also finishes if the workers are gone, like in a forked process.*/
+  void run(int num, function<void(int)> fun);
+
+  private:
+  void workerLoop();
+  bool runNext(std::unique_lock<std::mutex>&);
+  std::mutex mut;
+  std::condition_variable jobAdded;
+  std::condition_variable jobFinished;
+  function<void(int)> job;
+  int jobSize = 0;
+  int nextIndex = 0;
+  int numFinished = 0;
+  bool done = false;
+  vector<thread> threads;
+};
+
 thread makeThread(function<void()> fun);
 
 void openUrl(const string& url);
@@ -566,6 +566,7 @@ void WindowView::updateView(CreatureView* view, bool noRefresh) {
     return;
   gameInfo = {};
   view->refreshGameInfo(gameInfo);
+  gameInfo.computeStamps();
   if (gameInfo.infoType != GameInfo::InfoType::BAND)
     guiBuilder.clearActiveButton();
   wasRendered = false;
@@ -647,6 +648,33 @@ void WindowView::drawMap() {
       dragged->render(renderer);
     }
   guiBuilder.addFpsCounterTick();
+  Profiler::finishInterval(Profiler::Interval::FRAME);
+  if (Profiler::isOverlayEnabled())
+    drawProfilerOverlay();
+}
+
+void WindowView::drawProfilerOverlay() {
+  const int maxDepth = 3;
+  const int maxLines = 20;
+  const int lineHeight = 16;
+  const int textSize = 14;
+  Vec2 pos(10, 10);
+  for (auto interval : {Profiler::Interval::TURN, Profiler::Interval::FRAME}) {
+    vector<string> lines {interval == Profiler::Interval::TURN ? "Last turn" : "Last frame"};
+    for (auto& entry : Profiler::getLastTree(interval))
+      if (entry.depth < maxDepth && lines.size() < maxLines)
+        lines.push_back(string(2 * entry.depth, ' ') + entry.name + " " + toString(int(entry.millis * 100) / 100.0)
+            + "ms x" + toString(entry.count));
+    int width = 0;
+    for (auto& line : lines)
+      width = max(width, renderer.getTextLength(line, textSize));
+    renderer.drawFilledRectangle(Rectangle(pos, pos + Vec2(width + 10, lines.size() * lineHeight + 6)),
+        Color::BLACK.transparency(180));
+    for (int i : All(lines))
+      renderer.drawText(i == 0 ? Color::YELLOW : Color::WHITE, pos + Vec2(5, 3 + i * lineHeight), lines[i],
+          Renderer::NONE, textSize);
+    pos.y += lines.size() * lineHeight + 16;
+  }
 }
 
 static Rectangle getBugReportPos(Renderer& renderer) {
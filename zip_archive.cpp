@@ -0,0 +1,121 @@
+#include "stdafx.h"
+#include "zip_archive.h"
+#include "unzip.h"
+
+static string getParent(const string& path) {
+  auto pos = path.rfind('/');
+  return pos == string::npos ? "" : path.substr(0, pos);
+}
+
+static string getChild(const string& dir, const string& name) {
+  return dir.empty() ? name : dir + "/" + name;
+}
+
+static time_t getTime(const tm_unz& date) {
+  struct tm t {};
+  t.tm_sec = date.tm_sec;
+  t.tm_min = date.tm_min;
+  t.tm_hour = date.tm_hour;
+  t.tm_mday = date.tm_mday;
+  t.tm_mon = date.tm_mon;
+  t.tm_year = date.tm_year - 1900;
+  t.tm_isdst = -1;
+  return mktime(&t);
+}
+
+shared_ptr<ZipArchive> ZipArchive::open(const string& path) {
+  auto handle = unzOpen(path.data());
+  if (!handle)
+    return nullptr;
+  shared_ptr<ZipArchive> ret(new ZipArchive(path, handle));
+  ret->addDirectory("");
+  for (int err = unzGoToFirstFile(handle); err == UNZ_OK; err = unzGoToNextFile(handle)) {
+    unz_file_info info;
+    unz_file_pos pos;
+    if (unzGetCurrentFileInfo(handle, &info, nullptr, 0, nullptr, 0, nullptr, 0) != UNZ_OK)
+      return nullptr;
+    string entryName(info.size_filename + 1, 0);
+    if (unzGetCurrentFileInfo(handle, nullptr, &entryName[0], entryName.size(), nullptr, 0, nullptr, 0) != UNZ_OK ||
+        unzGetFilePos(handle, &pos) != UNZ_OK)
+      return nullptr;
+    entryName.resize(info.size_filename);
+    std::replace(entryName.begin(), entryName.end(), '\\', '/');
+    if (!entryName.empty() && entryName.back() == '/')
+      ret->addDirectory(entryName.substr(0, entryName.size() - 1));
+    else {
+      ret->addDirectory(getParent(entryName));
+      ret->files[entryName] = Entry{pos.pos_in_zip_directory, pos.num_of_file, info.uncompressed_size,
+          getTime(info.tmu_date)};
+    }
+  }
+  return ret;
+}
+
+ZipArchive::ZipArchive(const string& p, void* h) : path(p), handle(h) {
+}
+
+ZipArchive::~ZipArchive() {
+  unzClose(handle);
+}
+
+// Zips don't need to have entries for directories, so they are also added for the parents of every file.
+void ZipArchive::addDirectory(const string& dir) {
+  if (directories.count(dir))
+    return;
+  directories[dir];
+  if (!dir.empty()) {
+    auto parent = getParent(dir);
+    addDirectory(parent);
+    directories[parent].insert(dir.substr(parent.empty() ? 0 : parent.size() + 1));
+  }
+}
+
+const string& ZipArchive::getPath() const {
+  return path;
+}
+
+bool ZipArchive::hasFile(const string& file) const {
+  return files.count(file);
+}
+
+bool ZipArchive::hasDirectory(const string& dir) const {
+  return directories.count(dir);
+}
+
+vector<string> ZipArchive::getFiles(const string& dir) const {
+  vector<string> ret;
+  auto prefix = dir.empty() ? dir : dir + "/";
+  for (auto it = files.lower_bound(prefix); it != files.end() && it->first.compare(0, prefix.size(), prefix) == 0;
+      ++it)
+    if (it->first.find('/', prefix.size()) == string::npos)
+      ret.push_back(it->first.substr(prefix.size()));
+  return ret;
+}
+
+vector<string> ZipArchive::getSubDirs(const string& dir) const {
+  if (auto subdirs = getReferenceMaybe(directories, dir))
+    return vector<string>(subdirs->begin(), subdirs->end());
+  return {};
+}
+
+optional<string> ZipArchive::readFile(const string& file) const {
+  auto entry = getReferenceMaybe(files, file);
+  if (!entry)
+    return none;
+  RecursiveLock lock(mutex);
+  unz_file_pos pos {entry->posInDirectory, entry->fileNum};
+  if (unzGoToFilePos(handle, &pos) != UNZ_OK || unzOpenCurrentFile(handle) != UNZ_OK)
+    return none;
+  string ret(entry->size, 0);
+  int numRead = entry->size > 0 ? unzReadCurrentFile(handle, &ret[0], entry->size) : 0;
+  // Closing checks the CRC once the whole entry has been read.
+  if (unzCloseCurrentFile(handle) != UNZ_OK || numRead != entry->size)
+    return none;
+  return ret;
+}
+
+time_t ZipArchive::getModificationTime(const string& file) const {
+  if (auto entry = getReferenceMaybe(files, file))
+    return entry->modificationTime;
+  return 0;
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "util.h"
+
+/** Read-only view of a zip file. The central directory is read once into an index of files and directories,
+    and entries are decompressed into memory on request, so nothing is extracted to disk. Paths are relative
+    to the root of the archive, separated with '/'.*/
+class ZipArchive {
+  public:
+  /** Returns nullptr if the file can't be opened as a zip.*/
+  static shared_ptr<ZipArchive> open(const string& path);
+  ~ZipArchive();
+
+  const string& getPath() const;
+  bool hasFile(const string&) const;
+  bool hasDirectory(const string&) const;
+  vector<string> getFiles(const string& dir) const;
+  vector<string> getSubDirs(const string& dir) const;
+  optional<string> readFile(const string&) const;
+  time_t getModificationTime(const string&) const;
+
+  private:
+  ZipArchive(const string& path, void* handle);
+  struct Entry {
+    unsigned long posInDirectory;
+    unsigned long fileNum;
+    unsigned long size;
+    time_t modificationTime;
+  };
+  void addDirectory(const string&);
+  string path;
+  void* handle;
+  map<string, Entry> files;
+  // Maps each directory to its direct subdirectories, the root is the empty string.
+  map<string, set<string>> directories;
+  // The zip handle has a current entry, so reads from different threads must not interleave.
+  mutable recursive_mutex mutex;
+};
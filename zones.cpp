@@ -5,6 +5,7 @@
 #include "movement_type.h"
 #include "collective.h"
 #include "territory.h"
+#include "memory_report.h"
 
 SERIALIZE_DEF(Zones, positions, zones)
 SERIALIZATION_CONSTRUCTOR_IMPL(Zones)
@@ -28,6 +29,7 @@ void Zones::setZone(Position pos, ZoneId id) {
   PROFILE;
   zones.getOrInit(pos).insert(id);
   positions[id].insert(pos);
+  epoch.bump();
   pos.setNeedsRenderAndMemoryUpdate(true);
 }
 
@@ -35,6 +37,7 @@ void Zones::eraseZone(Position pos, ZoneId id) {
   PROFILE;
   zones.getOrInit(pos).erase(id);
   positions[id].erase(pos);
+  epoch.bump();
   pos.setNeedsRenderAndMemoryUpdate(true);
 }
 
@@ -54,6 +57,10 @@ const PositionSet& Zones::getPositions(ZoneId id) const {
   return positions[id];
 }
 
+long long Zones::getEpoch() const {
+  return epoch.get();
+}
+
 static HighlightType getHighlight(ZoneId id) {
   switch (id) {
     case ZoneId::FETCH_ITEMS:
@@ -123,3 +130,9 @@ ViewId getViewId(ZoneId id) {
       return ViewId("storage_resources");
   }
 }
+
+void Zones::reportMemory(MemoryReport& report) const {
+  zones.reportMemory(report);
+  for (auto zone : ENUM_ALL(ZoneId))
+    report.addNodes(positions[zone]);
+}
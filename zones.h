@@ -3,6 +3,7 @@
 #include "util.h"
 #include "position.h"
 #include "position_map.h"
+#include "memo.h"
 
 RICH_ENUM(ZoneId,
   FETCH_ITEMS,
@@ -17,6 +18,7 @@ RICH_ENUM(ZoneId,
 
 class Position;
 class ViewIndex;
+class MemoryReport;
 
 extern ViewId getViewId(ZoneId);
 
@@ -28,13 +30,17 @@ class Zones {
   void eraseZone(Position, ZoneId);
   void onDestroyOrder(Position);
   const PositionSet& getPositions(ZoneId) const;
+  /** Changes whenever a zone is set or erased.*/
+  long long getEpoch() const;
   void setHighlights(Position, ViewIndex&) const;
   bool canSet(Position, ZoneId, WConstCollective) const;
   void tick();
+  void reportMemory(MemoryReport&) const;
 
   SERIALIZATION_DECL(Zones)
 
   private:
   EnumMap<ZoneId, PositionSet> SERIAL(positions);
   PositionMap<EnumSet<ZoneId>> SERIAL(zones);
+  DirtyEpoch epoch;
 };